@@ -0,0 +1,30 @@
+#ifndef ZYRA_HASH_H
+#define ZYRA_HASH_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace zyra {
+
+// Hash de conteúdo (FNV-1a 64 bits) em hexadecimal.
+// Usado para versionar arquivos gerados; não é criptográfico.
+inline std::string contentHash(std::string_view data) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; i--) {
+        hex[i] = digits[hash & 0xf];
+        hash >>= 4;
+    }
+    return hex;
+}
+
+} // namespace zyra
+
+#endif
@@ -0,0 +1,71 @@
+#include "interner.hpp"
+#include <mutex>
+#include <stdexcept>
+
+namespace zyra {
+
+// Nomes pré-registrados, na ordem de sym::
+static const char* const predefined[] = {
+    "",
+    "component", "state", "style", "interface", "eventos", "if", "else",
+    "texto", "conteudo", "acao", "Botao", "cor", "fundo", "tamanho"
+};
+
+static_assert(sizeof(predefined) / sizeof(predefined[0]) == sym::PREDEFINED_END,
+              "Tabela de símbolos pré-registrados fora de sincronia com sym::");
+
+Interner::Interner() {
+    for (const char* text : predefined) {
+        names.emplace_back(text);
+        ids.emplace(names.back(), static_cast<Symbol>(names.size() - 1));
+    }
+}
+
+// Tabela instalada pelo InternerScope ativo na thread
+static thread_local Interner* active = nullptr;
+
+Interner& Interner::current() {
+    if (active) return *active;
+    static Interner fallback;
+    return fallback;
+}
+
+Symbol Interner::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(text);
+        if (it != ids.end()) return it->second;
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(text);  // Outra thread pode ter registrado antes
+    if (it != ids.end()) return it->second;
+    
+    names.emplace_back(text);
+    Symbol symbol = static_cast<Symbol>(names.size() - 1);
+    ids.emplace(names.back(), symbol);
+    return symbol;
+}
+
+const std::string& Interner::name(Symbol symbol) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    if (symbol >= names.size()) {
+        throw std::runtime_error("Símbolo desconhecido: " + std::to_string(symbol));
+    }
+    return names[symbol];
+}
+
+size_t Interner::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return names.size();
+}
+
+InternerScope::InternerScope(Interner& interner) : previous(active) {
+    active = &interner;
+}
+
+InternerScope::~InternerScope() {
+    active = previous;
+}
+
+} // namespace zyra
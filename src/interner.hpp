@@ -0,0 +1,88 @@
+#ifndef ZYRA_INTERNER_H
+#define ZYRA_INTERNER_H
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace zyra {
+
+// Identificador compacto de um nome internado
+using Symbol = std::uint32_t;
+
+// Símbolos pré-registrados, com IDs fixos.
+// As palavras-chave vêm primeiro e na mesma ordem de TokenType.
+namespace sym {
+enum : Symbol {
+    NONE = 0,
+    
+    // Palavras-chave
+    COMPONENT,
+    STATE,
+    STYLE,
+    INTERFACE,
+    EVENTOS,
+    IF,
+    ELSE,
+    KEYWORDS_END,
+    
+    // Propriedades e elementos conhecidos pelo gerador
+    TEXTO = KEYWORDS_END,
+    CONTEUDO,
+    ACAO,
+    BOTAO,
+    COR,
+    FUNDO,
+    TAMANHO,
+    PREDEFINED_END
+};
+} // namespace sym
+
+// Tabela de nomes: cada nome distinto é guardado uma única vez e
+// identificado por um Symbol. Segura para uso entre threads.
+// Os nomes nunca são removidos; por isso cada build (e cada sessão do lexer
+// incremental) usa a sua própria tabela, descartada no fim. Os símbolos
+// pré-registrados têm o mesmo ID em todas as tabelas.
+class Interner {
+public:
+    Interner();
+    Interner(const Interner&) = delete;
+    Interner& operator=(const Interner&) = delete;
+    
+    // Tabela em uso na thread: a instalada pelo InternerScope mais recente
+    // ou, fora de qualquer escopo, uma tabela padrão do processo
+    static Interner& current();
+    
+    // Retorna o símbolo do nome, registrando-o se ainda não existir
+    Symbol intern(std::string_view text);
+    
+    // Retorna o nome de um símbolo (a referência continua válida)
+    const std::string& name(Symbol symbol) const;
+    
+    // Quantidade de nomes registrados (inclui os pré-registrados)
+    size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> names;  // deque: endereços estáveis para as chaves
+    std::unordered_map<std::string_view, Symbol> ids;
+};
+
+// Instala uma tabela como a atual da thread enquanto o escopo existir
+class InternerScope {
+public:
+    explicit InternerScope(Interner& interner);
+    ~InternerScope();
+    InternerScope(const InternerScope&) = delete;
+    InternerScope& operator=(const InternerScope&) = delete;
+
+private:
+    Interner* previous;
+};
+
+} // namespace zyra
+
+#endif
@@ -1,11 +1,75 @@
 #include "interpreter.hpp"
-#include <fstream>
-#include <sstream>
+#include "optimizer.hpp"
+#include "output_writer.hpp"
+#include "runtime.hpp"
+#include "service_worker.hpp"
+#include "unicode.hpp"
+#include <algorithm>
 #include <filesystem>
+#include <sstream>
 
 namespace zyra {
 
+// Documento HTML de uma página
+std::string pageDocument(const std::string& title, const std::string& body) {
+    std::stringstream html;
+    html << "<!DOCTYPE html>\n";
+    html << "<html>\n<head>\n";
+    html << "<meta charset=\"UTF-8\">\n";
+    html << "<title>" << title << "</title>\n";
+    html << "</head>\n<body>\n";
+    html << body;
+    html << "</body>\n</html>";
+    return html.str();
+}
+
 // Implementação dos métodos de Component
+std::vector<Symbol> Component::references() const {
+    std::vector<Symbol> names;
+    for (const auto& child : children) {
+        if (auto* interface = dynamic_cast<Interface*>(child.get())) {
+            names.insert(names.end(), interface->references.begin(), interface->references.end());
+        }
+    }
+    return names;
+}
+
+std::vector<const TextBinding*> Component::bindings() const {
+    std::vector<const TextBinding*> all;
+    for (const auto& child : children) {
+        if (auto* interface = dynamic_cast<Interface*>(child.get())) {
+            for (const auto& binding : interface->bindings) all.push_back(&binding);
+        }
+    }
+    return all;
+}
+
+// Métodos dos textos interpolados, um par por componente (mesmo com várias
+// interfaces): o nó de texto de cada trecho e a atualização dele
+static std::string templateMethods(const std::vector<const TextBinding*>& bindings) {
+    if (bindings.empty()) return "";
+    std::stringstream js;
+    
+    // Localiza uma única vez o nó de texto de cada trecho interpolado
+    js << "  bindTemplates() {\n";
+    for (size_t i = 0; i < bindings.size(); i++) {
+        js << "    this._t" << i << " = this.root.querySelector('[data-zt=\"" << bindings[i]->id
+           << "\"]').appendChild(document.createTextNode(''));\n";
+    }
+    js << "  }\n\n";
+    
+    // Atualiza só os nós cujo valor mudou, sem montar a string inteira
+    js << "  updateTemplates() {\n";
+    for (size_t i = 0; i < bindings.size(); i++) {
+        js << "    const v" << i << " = this." << bindings[i]->path << ";\n";
+        js << "    if (v" << i << " !== this._v" << i << ") { this._v" << i << " = v" << i
+           << "; this._t" << i << ".data = v" << i << "; }\n";
+    }
+    js << "  }\n\n";
+    
+    return js.str();
+}
+
 std::string Component::generateHTML() {
     std::stringstream html;
     html << "<div class=\"component " << name << "\" id=\"" << name << "\">\n";
@@ -20,43 +84,17 @@ std::string Component::generateHTML() {
 
 std::string Component::generateJS() {
     std::stringstream js;
-    js << "class " << name << " {\n";
-    js << "  constructor() {\n";
-    js << "    this.init();\n";
-    js << "    this.setupEvents();\n";
-    js << "  }\n\n";
-    
-    // Adiciona o método setupEvents
-    js << "  setupEvents() {\n";
-    js << "    // Configura os eventos dos botões\n";
-    js << "    const buttons = document.querySelectorAll('button');\n";
-    js << "    buttons.forEach(button => {\n";
-    js << "      const action = button.getAttribute('data-action');\n";
-    js << "      if (action && typeof this[action] === 'function') {\n";
-    js << "        button.onclick = () => this[action]();\n";
-    js << "      }\n";
-    js << "    });\n";
-    js << "  }\n\n";
-    
-    // Adiciona o método updateView
-    js << "  updateView() {\n";
-    js << "    // Atualiza o texto dos elementos\n";
-    js << "    const elements = document.querySelectorAll('[data-bind]');\n";
-    js << "    elements.forEach(element => {\n";
-    js << "      const binding = element.getAttribute('data-bind');\n";
-    js << "      if (binding && this[binding] !== undefined) {\n";
-    js << "        element.textContent = this[binding];\n";
-    js << "      }\n";
-    js << "    });\n";
-    js << "  }\n\n";
+    // Os helpers (setupEvents, updateView) vêm do runtime compartilhado
+    js << "class " << name << " extends ZyraComponent {\n";
     
     for (const auto& child : children) {
         js << child->generateJS();
     }
+    js << templateMethods(bindings());
     
     js << "}\n\n";
-    js << "// Inicializa o componente\n";
-    js << "new " << name << "();\n";
+    js << "// Inicializa o componente (se estiver presente na página)\n";
+    js << "{ const root = document.getElementById('" << name << "'); if (root) new " << name << "(root); }\n";
     return js.str();
 }
 
@@ -70,7 +108,7 @@ std::string State::generateJS() {
     js << "  init() {\n";
     
     for (const auto& var : variables) {
-        js << "    this." << var.first << " = ";
+        js << "    this." << Interner::current().name(var.first) << " = ";
         
         // Se o valor começa com aspas, é uma string
         if (var.second[0] == '"') {
@@ -99,27 +137,30 @@ std::string Style::generateHTML() {
     
     for (const auto& prop : properties) {
         // Converte as propriedades para CSS válido
-        std::string cssName = prop.first;
-        std::string cssValue = prop.second;
-        
-        if (cssName == "cor") cssName = "color";
-        else if (cssName == "fundo") cssName = "background-color";
-        else if (cssName == "tamanho") cssName = "font-size";
+        const char* cssName;
+        switch (prop.first) {
+            case sym::COR: cssName = "color"; break;
+            case sym::FUNDO: cssName = "background-color"; break;
+            case sym::TAMANHO: cssName = "font-size"; break;
+            default: cssName = Interner::current().name(prop.first).c_str(); break;
+        }
         
-        css << "  " << cssName << ": " << cssValue << ";\n";
+        css << "  " << cssName << ": " << prop.second << ";\n";
     }
     
     css << "}\n";
     
     // Adiciona alguns estilos básicos
-    css << "\n/* Estilos básicos */\n";
-    css << "button {\n";
-    css << "  padding: 10px 20px;\n";
-    css << "  border: none;\n";
-    css << "  border-radius: 5px;\n";
-    css << "  cursor: pointer;\n";
-    css << "  margin: 5px;\n";
-    css << "}\n";
+    if (buttonRules) {
+        css << "\n/* Estilos básicos */\n";
+        css << "button {\n";
+        css << "  padding: 10px 20px;\n";
+        css << "  border: none;\n";
+        css << "  border-radius: 5px;\n";
+        css << "  cursor: pointer;\n";
+        css << "  margin: 5px;\n";
+        css << "}\n";
+    }
     
     css << "</style>\n";
     return css.str();
@@ -147,6 +188,7 @@ std::string Interface::generateJS() {
         js << element->generateJS();
     }
     
+    // Os métodos dos textos interpolados saem em Component::generateJS
     return js.str();
 }
 
@@ -155,64 +197,121 @@ std::string Event::generateHTML() {
     return ""; // Eventos não geram HTML diretamente
 }
 
+std::vector<Symbol> Event::references() const {
+    std::vector<Symbol> names;
+    for (const auto& token : body) {
+        if (token.type == TokenType::IDENTIFIER) names.push_back(token.symbol);
+    }
+    return names;
+}
+
 std::string Event::generateJS() {
+    std::stringstream code;
+    for (const auto& token : body) {
+        if (token.type == TokenType::IDENTIFIER) code << "this.";
+        code << token.text(Interner::current()) << " ";
+    }
+    
     std::stringstream js;
-    js << "  " << name << "() {\n";
-    js << "    " << code << "\n";
+    js << "  " << Interner::current().name(name) << "() {\n";
+    js << "    " << code.str() << "\n";
     js << "    this.updateView();\n";  // Atualiza a view após o evento
     js << "  }\n\n";
     return js.str();
 }
 
 // Implementação do Interpretador
-Interpreter::Interpreter(std::vector<Token> tokens) : tokens(std::move(tokens)) {}
+Interpreter::Interpreter(std::vector<Token> tokens, BuildOptions options, Interner& names)
+    : tokens(std::move(tokens)), options(options), names(names) {}
 
-void Interpreter::generate(const std::string& outputDir) {
-    // Cria o diretório de saída se não existir
-    std::filesystem::create_directories(outputDir);
-    
-    // Gera o HTML
-    std::ofstream htmlFile(outputDir + "/index.html");
-    htmlFile << "<!DOCTYPE html>\n";
-    htmlFile << "<html>\n<head>\n";
-    htmlFile << "<meta charset=\"UTF-8\">\n";
-    htmlFile << "<title>Site Zyra</title>\n";
+std::vector<std::unique_ptr<Component>> Interpreter::parse() {
+    current = 0;
+    std::vector<std::unique_ptr<Component>> components;
     
-    // Processa os componentes
-    std::stringstream components;
-    std::stringstream scripts;
+    reports.clear();
     
     while (!isAtEnd()) {
         if (match(TokenType::COMPONENT)) {
-            auto component = parseComponent();
-            components << component->generateHTML();
-            
-            // Gera o JavaScript do componente
-            std::string jsFilename = component->name + ".js";
-            std::ofstream jsFile(outputDir + "/" + jsFilename);
-            jsFile << component->generateJS();
-            jsFile.close();
-            
-            // Adiciona o script ao HTML
-            scripts << "<script src=\"" << jsFilename << "\"></script>\n";
+            components.push_back(parseComponent());
+            if (options.eliminateDeadCode) {
+                reports.push_back(eliminateDeadCode(*components.back()));
+            }
         } else {
             advance(); // Pula tokens desconhecidos
         }
     }
     
-    htmlFile << "</head>\n<body>\n";
-    htmlFile << components.str();
-    htmlFile << scripts.str();
-    htmlFile << "</body>\n</html>";
-    htmlFile.close();
+    return components;
+}
+
+std::vector<Artifact> Interpreter::build() {
+    std::vector<Artifact> artifacts;
+    
+    auto parsed = parse();
+    if (options.eliminateDeadCode) {
+        std::vector<Component*> all;
+        for (const auto& component : parsed) all.push_back(component.get());
+        eliminateButtonRules(all, reports);
+    }
+    
+    // Processa os componentes
+    std::stringstream components;
+    std::stringstream scripts;
+    
+    // O runtime compartilhado é carregado antes de qualquer componente
+    artifacts.push_back({runtimeFileName(), runtimeSource()});
+    scripts << "<script src=\"" << runtimeFileName() << "\"></script>\n";
+    
+    for (const auto& component : parsed) {
+        components << component->generateHTML();
+        
+        // Gera o JavaScript do componente
+        std::string jsFilename = component->name + ".js";
+        artifacts.push_back({jsFilename, component->generateJS()});
+        
+        // Adiciona o script ao HTML
+        scripts << "<script src=\"" << jsFilename << "\"></script>\n";
+    }
+    
+    if (options.serviceWorker) {
+        scripts << serviceWorkerRegistration();
+    }
+    
+    artifacts.push_back({"index.html", pageDocument("Site Zyra", components.str() + scripts.str())});
+    
+    if (options.serviceWorker) {
+        addServiceWorker(artifacts);
+    }
+    
+    return artifacts;
+}
+
+WriteStats Interpreter::generate(const std::string& outputDir) {
+    return writeArtifacts(outputDir, build());
+}
+
+WriteStats writeArtifacts(const std::string& outputDir, std::vector<Artifact> artifacts) {
+    // Build sem service worker sobre a saída de um build com: o sw.js antigo
+    // é trocado por um que desinstala o worker
+    bool hasWorker = std::any_of(artifacts.begin(), artifacts.end(),
+                                 [](const Artifact& artifact) { return artifact.path == "sw.js"; });
+    if (!hasWorker && std::filesystem::exists(std::filesystem::path(outputDir) / "sw.js")) {
+        retireServiceWorker(artifacts);
+    }
+    
+    OutputWriter writer(outputDir);
+    for (auto& artifact : artifacts) {
+        writer.write(std::move(artifact));
+    }
+    return writer.finish();
 }
 
 // Métodos auxiliares de parsing
 std::unique_ptr<Component> Interpreter::parseComponent() {
-    Token name = consume(TokenType::IDENTIFIER, "Esperado nome do componente");
+    const Token& name = consume(TokenType::IDENTIFIER, "Esperado nome do componente");
     consume(TokenType::LEFT_BRACE, "Esperado '{' após nome do componente");
     
-    auto component = std::make_unique<Component>(name.lexeme);
+    auto component = std::make_unique<Component>(name.text(names));
     
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
         if (match(TokenType::STATE)) {
@@ -220,9 +319,11 @@ std::unique_ptr<Component> Interpreter::parseComponent() {
         } else if (match(TokenType::STYLE)) {
             component->children.push_back(parseStyle());
         } else if (match(TokenType::INTERFACE)) {
-            component->children.push_back(parseInterface());
+            component->children.push_back(parseInterface(*component));
         } else if (match(TokenType::EVENTOS)) {
-            component->children.push_back(parseEvent());
+            for (auto& event : parseEvents()) {
+                component->children.push_back(std::move(event));
+            }
         } else {
             advance(); // Pula tokens desconhecidos
         }
@@ -237,11 +338,11 @@ std::unique_ptr<State> Interpreter::parseState() {
     auto state = std::make_unique<State>();
     
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-        Token name = consume(TokenType::IDENTIFIER, "Esperado nome da variável");
+        Symbol name = consume(TokenType::IDENTIFIER, "Esperado nome da variável").symbol;
         consume(TokenType::COLON, "Esperado ':' após nome da variável");
-        Token value = advance(); // Pode ser STRING, NUMBER, etc.
+        const Token& value = advance(); // Pode ser STRING, NUMBER, etc.
         
-        state->variables.emplace_back(name.lexeme, value.lexeme);
+        state->variables.emplace_back(name, value.text(names));
     }
     
     consume(TokenType::RIGHT_BRACE, "Esperado '}' após declarações de estado");
@@ -253,46 +354,51 @@ std::unique_ptr<Style> Interpreter::parseStyle() {
     auto style = std::make_unique<Style>();
     
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-        Token prop = consume(TokenType::IDENTIFIER, "Esperado nome da propriedade");
+        Symbol prop = consume(TokenType::IDENTIFIER, "Esperado nome da propriedade").symbol;
         consume(TokenType::COLON, "Esperado ':' após nome da propriedade");
-        Token value = advance(); // Pode ser COLOR, UNIT, etc.
+        const Token& value = advance(); // Pode ser COLOR, UNIT, etc.
         
-        style->properties.emplace_back(prop.lexeme, value.lexeme);
+        style->properties.emplace_back(prop, value.text(names));
     }
     
     consume(TokenType::RIGHT_BRACE, "Esperado '}' após declarações de estilo");
     return style;
 }
 
-std::unique_ptr<Interface> Interpreter::parseInterface() {
+std::unique_ptr<Interface> Interpreter::parseInterface(const Component& component) {
     consume(TokenType::LEFT_BRACE, "Esperado '{' após 'interface'");
     auto interface = std::make_unique<Interface>();
     
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-        Token element = consume(TokenType::IDENTIFIER, "Esperado nome do elemento");
+        const Token& element = consume(TokenType::IDENTIFIER, "Esperado nome do elemento");
         consume(TokenType::LEFT_BRACE, "Esperado '{' após nome do elemento");
+        interface->references.push_back(element.symbol);
         
         // Processa as propriedades do elemento
         std::stringstream html;
-        std::string tag = element.lexeme == "Botao" ? "button" : "div";
-        html << "<" << tag << " class=\"" << element.lexeme << "\"";
+        const char* tag = element.symbol == sym::BOTAO ? "button" : "div";
+        html << "<" << tag << " class=\"" << element.text(names) << "\"";
         
         std::string texto;
         std::string acao;
         
         while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-            Token prop = consume(TokenType::IDENTIFIER, "Esperado nome da propriedade");
+            Symbol prop = consume(TokenType::IDENTIFIER, "Esperado nome da propriedade").symbol;
             consume(TokenType::COLON, "Esperado ':' após nome da propriedade");
-            Token value = advance(); // Pode ser STRING, IDENTIFIER, etc.
+            const Token& value = advance(); // Pode ser STRING, IDENTIFIER, etc.
             
-            if (prop.lexeme == "texto") {
-                texto = value.lexeme;
+            if (prop == sym::TEXTO || prop == sym::CONTEUDO) {
+                texto = value.text(names);
                 if (value.type == TokenType::IDENTIFIER) {
-                    html << " data-bind=\"" << value.lexeme << "\"";
+                    html << " data-bind=\"" << value.text(names) << "\"";
+                    interface->reads.push_back(value.symbol);
+                } else if (value.type == TokenType::STRING && texto.find("${") != std::string::npos) {
+                    texto = compileTemplate(value, component, *interface);
                 }
-            } else if (prop.lexeme == "acao") {
-                acao = value.lexeme;
-                html << " data-action=\"" << value.lexeme << "\"";
+            } else if (prop == sym::ACAO) {
+                acao = value.text(names);
+                interface->actions.push_back(names.intern(acao));
+                html << " data-action=\"" << acao << "\"";
             }
         }
         
@@ -317,48 +423,107 @@ std::unique_ptr<Interface> Interpreter::parseInterface() {
     return interface;
 }
 
-std::unique_ptr<Event> Interpreter::parseEvent() {
+// Caminho no estado: nomes separados por '.', cada um um identificador
+// válido (XID_Start ou '_' seguido de XID_Continue)
+static bool isStatePath(const std::string& path) {
+    bool segmentStart = true;
+    for (size_t i = 0; i < path.length();) {
+        if (path[i] == '.') {
+            if (segmentStart) return false;  // Segmento vazio
+            segmentStart = true;
+            i++;
+            continue;
+        }
+        
+        std::uint32_t cp;
+        int size = decodeUtf8(path.data() + i, path.length() - i, cp);
+        if (size == 0) return false;
+        bool ok = segmentStart ? (cp == '_' || isXidStart(cp)) : isXidContinue(cp);
+        if (!ok) return false;
+        segmentStart = false;
+        i += size;
+    }
+    return !segmentStart;  // Rejeita caminho vazio e '.' no final
+}
+
+// Compila um texto interpolado ("Contador: ${contador}") em tempo de build.
+// As partes estáticas vão direto para o HTML; cada ${caminho} vira um nó de
+// texto próprio, atualizado pelo código gerado em Component::generateJS.
+// Os trechos são numerados por componente: a interface atual ainda não está
+// entre os filhos, então a numeração continua a das anteriores.
+std::string Interpreter::compileTemplate(const Token& value, const Component& component, Interface& interface) {
+    const std::string& text = value.lexeme;
+    std::stringstream html;
+    size_t pos = 0;
+    
+    while (pos < text.length()) {
+        size_t open = text.find("${", pos);
+        if (open == std::string::npos) {
+            html << text.substr(pos);
+            break;
+        }
+        
+        size_t close = text.find('}', open + 2);
+        if (close == std::string::npos) {
+            throw std::runtime_error("Interpolação não terminada na linha " + std::to_string(value.line));
+        }
+        
+        // Aceita apenas caminhos no estado: nome ou nome.campo
+        std::string path = text.substr(open + 2, close - open - 2);
+        path.erase(0, path.find_first_not_of(" \t"));
+        path.erase(path.find_last_not_of(" \t") + 1);
+        
+        if (!isStatePath(path)) {
+            throw std::runtime_error("Interpolação inválida '${" + path + "}' na linha " + std::to_string(value.line));
+        }
+        
+        size_t index = component.bindings().size() + interface.bindings.size();
+        std::string id = component.name + ":" + std::to_string(index);
+        interface.bindings.push_back({id, path});
+        interface.reads.push_back(names.intern(path.substr(0, path.find('.'))));
+        
+        html << text.substr(pos, open - pos);
+        html << "<span data-zt=\"" << id << "\"></span>";
+        pos = close + 1;
+    }
+    
+    return html.str();
+}
+
+std::vector<std::unique_ptr<Event>> Interpreter::parseEvents() {
     consume(TokenType::LEFT_BRACE, "Esperado '{' após 'eventos'");
     
     std::vector<std::unique_ptr<Event>> events;
     
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-        Token name = consume(TokenType::IDENTIFIER, "Esperado nome do evento");
+        Symbol name = consume(TokenType::IDENTIFIER, "Esperado nome do evento").symbol;
         consume(TokenType::ARROW, "Esperado '->' após nome do evento");
         consume(TokenType::LEFT_BRACE, "Esperado '{' após '->'");
         
-        std::stringstream code;
+        std::vector<Token> body;
         while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-            Token token = advance();
-            if (token.type == TokenType::IDENTIFIER) {
-                code << "this." << token.lexeme;
-            } else {
-                code << token.lexeme;
-            }
-            code << " ";
+            body.push_back(advance());
         }
         
         consume(TokenType::RIGHT_BRACE, "Esperado '}' após código do evento");
-        events.push_back(std::make_unique<Event>(name.lexeme, code.str()));
+        events.push_back(std::make_unique<Event>(name, std::move(body)));
     }
     
     consume(TokenType::RIGHT_BRACE, "Esperado '}' após eventos");
-    
-    // Retorna o primeiro evento (por enquanto)
-    return std::move(events[0]);
+    return events;
 }
 
 // Métodos auxiliares para consumir tokens
-Token Interpreter::advance() {
+const Token& Interpreter::advance() {
     if (!isAtEnd()) current++;
     return previous();
 }
 
-Token Interpreter::peek() {
+const Token& Interpreter::peek() {
     return tokens[current];
 }
 
-Token Interpreter::previous() {
+const Token& Interpreter::previous() {
     return tokens[current - 1];
 }
 
@@ -370,7 +535,7 @@ bool Interpreter::match(TokenType type) {
     return false;
 }
 
-Token Interpreter::consume(TokenType type, const std::string& message) {
+const Token& Interpreter::consume(TokenType type, const std::string& message) {
     if (check(type)) return advance();
     throw std::runtime_error(message);
 }
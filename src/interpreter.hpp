@@ -27,6 +27,12 @@ public:
     std::string generateJS() override { return ""; }
 };
 
+// Trecho dinâmico de um texto interpolado ("Contador: ${contador}")
+struct TextBinding {
+    std::string id;    // Valor de data-zt do elemento que guarda o nó de texto
+    std::string path;  // Caminho no estado (ex.: contador, usuario.nome)
+};
+
 // Componente
 class Component : public Node {
 public:
@@ -35,6 +41,12 @@ public:
     
     Component(std::string n) : name(std::move(n)) {}
     
+    // Nomes dos elementos usados na interface (podem ser outros componentes)
+    std::vector<Symbol> references() const;
+    
+    // Textos interpolados de todas as interfaces, na ordem (numerados por componente)
+    std::vector<const TextBinding*> bindings() const;
+    
     std::string generateHTML() override;
     std::string generateJS() override;
 };
@@ -42,7 +54,7 @@ public:
 // Estado
 class State : public Node {
 public:
-    std::vector<std::pair<std::string, std::string>> variables;
+    std::vector<std::pair<Symbol, std::string>> variables;
     
     std::string generateHTML() override;
     std::string generateJS() override;
@@ -51,7 +63,8 @@ public:
 // Estilo
 class Style : public Node {
 public:
-    std::vector<std::pair<std::string, std::string>> properties;
+    std::vector<std::pair<Symbol, std::string>> properties;
+    bool buttonRules = true;  // Inclui os estilos básicos de botão
     
     std::string generateHTML() override;
     std::string generateJS() override;
@@ -61,6 +74,10 @@ public:
 class Interface : public Node {
 public:
     std::vector<std::unique_ptr<Node>> elements;
+    std::vector<TextBinding> bindings;
+    std::vector<Symbol> references;  // Nome de cada elemento, na ordem
+    std::vector<Symbol> reads;       // Estado lido pelos textos (data-bind e ${...})
+    std::vector<Symbol> actions;     // Eventos chamados pelos elementos (acao)
     
     std::string generateHTML() override;
     std::string generateJS() override;
@@ -69,41 +86,95 @@ public:
 // Eventos
 class Event : public Node {
 public:
-    std::string name;
-    std::string code;
+    Symbol name;
+    std::vector<Token> body;  // Tokens do código; o JS é montado na geração
     
-    Event(std::string n, std::string c) 
-        : name(std::move(n)), code(std::move(c)) {}
+    Event(Symbol n, std::vector<Token> b) 
+        : name(n), body(std::move(b)) {}
+    
+    // Identificadores usados no código
+    std::vector<Symbol> references() const;
     
     std::string generateHTML() override;
     std::string generateJS() override;
 };
 
+// Arquivo gerado pelo build (caminho relativo à pasta de saída)
+struct Artifact {
+    std::string path;
+    std::string content;
+};
+
+// Resultado da gravação dos arquivos gerados
+struct WriteStats {
+    size_t written = 0;    // Arquivos novos ou alterados
+    size_t unchanged = 0;  // Idênticos ao que já estava no disco (não regravados)
+    size_t removed = 0;    // Versões antigas de arquivos com hash no nome, apagadas
+};
+
+// Resultado da eliminação de código morto em um componente
+struct DceReport {
+    std::string component;
+    size_t bytesBefore = 0;     // HTML + JS gerados sem a otimização
+    size_t bytesAfter = 0;
+    size_t removedState = 0;    // Variáveis de estado removidas
+    size_t removedEvents = 0;   // Eventos removidos
+    size_t removedStyles = 0;   // Propriedades e regras de estilo removidas
+};
+
+// Opções de geração
+struct BuildOptions {
+    bool serviceWorker = false;     // Gera sw.js e o manifesto de precache
+    bool eliminateDeadCode = true;  // Remove estado, eventos e estilos não usados
+};
+
+// Grava os arquivos gerados na pasta de saída (em paralelo, atomicamente,
+// pulando os que não mudaram)
+WriteStats writeArtifacts(const std::string& outputDir, std::vector<Artifact> artifacts);
+
+// Documento HTML de uma página com o corpo já gerado
+std::string pageDocument(const std::string& title, const std::string& body);
+
 // Classe principal do interpretador
 class Interpreter {
 public:
-    explicit Interpreter(std::vector<Token> tokens);
+    // 'names' é a tabela em que o Lexer registrou os nomes dos tokens
+    explicit Interpreter(std::vector<Token> tokens, BuildOptions options = {},
+                         Interner& names = Interner::current());
+    
+    // Lê todos os componentes do fonte (já otimizados, conforme as opções)
+    std::vector<std::unique_ptr<Component>> parse();
+    
+    // Relatório da eliminação de código morto, um por componente
+    const std::vector<DceReport>& dceReport() const { return reports; }
+    
+    // Compila os componentes e retorna os arquivos gerados, sem gravar no disco
+    std::vector<Artifact> build();
     
     // Gera os arquivos finais
-    void generate(const std::string& outputDir);
+    WriteStats generate(const std::string& outputDir);
 
 private:
     std::vector<Token> tokens;
+    BuildOptions options;
+    Interner& names;
+    std::vector<DceReport> reports;
     int current = 0;
     
     // Métodos auxiliares para parsing
     std::unique_ptr<Component> parseComponent();
     std::unique_ptr<State> parseState();
     std::unique_ptr<Style> parseStyle();
-    std::unique_ptr<Interface> parseInterface();
-    std::unique_ptr<Event> parseEvent();
+    std::unique_ptr<Interface> parseInterface(const Component& component);
+    std::vector<std::unique_ptr<Event>> parseEvents();
+    std::string compileTemplate(const Token& value, const Component& component, Interface& interface);
     
     // Métodos auxiliares para consumir tokens
-    Token advance();
-    Token peek();
-    Token previous();
+    const Token& advance();
+    const Token& peek();
+    const Token& previous();
     bool match(TokenType type);
-    Token consume(TokenType type, const std::string& message);
+    const Token& consume(TokenType type, const std::string& message);
     bool check(TokenType type);
     bool isAtEnd();
 };
@@ -1,27 +1,58 @@
 #include "lexer.hpp"
+#include "unicode.hpp"
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <stdexcept>
-#include <unordered_map>
 #include <unordered_set>
 
 namespace zyra {
 
-// Mapa de palavras-chave
-static std::unordered_map<std::string, TokenType> keywords = {
-    {"component", TokenType::COMPONENT},
-    {"state", TokenType::STATE},
-    {"style", TokenType::STYLE},
-    {"interface", TokenType::INTERFACE},
-    {"eventos", TokenType::EVENTOS},
-    {"if", TokenType::IF},
-    {"else", TokenType::ELSE}
+// Palavras-chave indexadas pelo símbolo (sym::COMPONENT .. sym::ELSE)
+static const TokenType keywords[] = {
+    TokenType::COMPONENT,
+    TokenType::STATE,
+    TokenType::STYLE,
+    TokenType::INTERFACE,
+    TokenType::EVENTOS,
+    TokenType::IF,
+    TokenType::ELSE
 };
 
+static_assert(sizeof(keywords) / sizeof(keywords[0]) == sym::KEYWORDS_END - sym::COMPONENT,
+              "Palavras-chave fora de sincronia com sym::");
+
+// Classes de caracteres ASCII, consultadas por tabela (caminho rápido)
+enum : unsigned char {
+    CHAR_DIGIT = 1,
+    CHAR_ALPHA = 2,      // Letras ASCII e '_'
+    CHAR_IDENT = 4,      // Continua um identificador: letras, dígitos, '_' e '-'
+    CHAR_NON_ASCII = 8   // Byte de uma sequência UTF-8
+};
+
+static constexpr std::array<unsigned char, 256> buildCharClasses() {
+    std::array<unsigned char, 256> classes{};
+    for (int c = 0; c < 256; c++) {
+        if (c >= '0' && c <= '9') classes[c] = CHAR_DIGIT | CHAR_IDENT;
+        else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') classes[c] = CHAR_ALPHA | CHAR_IDENT;
+        else if (c == '-') classes[c] = CHAR_IDENT;
+        else if (c >= 0x80) classes[c] = CHAR_NON_ASCII;
+    }
+    return classes;
+}
+
+static constexpr std::array<unsigned char, 256> charClasses = buildCharClasses();
+
+static unsigned char classOf(char c) {
+    return charClasses[static_cast<unsigned char>(c)];
+}
+
 // Conjunto de unidades válidas
 static std::unordered_set<std::string> units = {
     "%", "px", "rem", "em", "vh", "vw", "s", "ms"
 };
 
-Lexer::Lexer(std::string source) : source(std::move(source)) {}
+Lexer::Lexer(std::string source, Interner& names) : source(std::move(source)), names(names) {}
 
 std::vector<Token> Lexer::scanTokens() {
     while (!isAtEnd()) {
@@ -30,6 +61,8 @@ std::vector<Token> Lexer::scanTokens() {
     }
     
     tokens.emplace_back(TokenType::EOF_TOKEN, "", line);
+    tokens.back().start = tokens.back().end = static_cast<int>(source.length());
+    scanEnds.push_back(static_cast<int>(source.length()) + 1);
     return tokens;
 }
 
@@ -61,7 +94,7 @@ void Lexer::scanToken() {
                 addToken(TokenType::MINUS_EQUALS);
             } else if (isDigit(peek())) {
                 number();
-            } else if (isAlpha(peek()) || peek() == '_') {
+            } else if (isAlpha(peek()) || unicodeIdentifierChar(current, true)) {
                 current--; // Volta para incluir o hífen
                 identifier();
             } else {
@@ -98,10 +131,13 @@ void Lexer::scanToken() {
         default:
             if (isDigit(c)) {
                 number();
-            } else if (isAlpha(c) || c == '_') {
+            } else if (isAlpha(c)) {
+                identifier();
+            } else if (int size = unicodeIdentifierChar(current - 1, true)) {
+                current += size - 1; // Consome o restante do caractere UTF-8
                 identifier();
             } else {
-                throw std::runtime_error("Caractere inesperado '" + std::string(1, c) + "' na linha " + std::to_string(line));
+                throw std::runtime_error("Caractere inesperado '" + describeChar(current - 1) + "' na linha " + std::to_string(line));
             }
             break;
     }
@@ -157,13 +193,25 @@ void Lexer::number() {
 }
 
 void Lexer::identifier() {
-    while (isAlphaNumeric(peek()) || peek() == '-' || peek() == '_') advance();
+    const int length = static_cast<int>(source.length());
+    while (true) {
+        // Caminho rápido: trechos ASCII classificados direto pela tabela;
+        // só os bytes não-ASCII passam pela decodificação UTF-8
+        while (current < length && (classOf(source[current]) & CHAR_IDENT)) current++;
+        touch(current + 1);
+        
+        int size = unicodeIdentifierChar(current, false);
+        if (size == 0) break;
+        current += size;
+    }
     
-    std::string text = source.substr(start, current - start);
-    auto it = keywords.find(text);
-    TokenType type = it != keywords.end() ? it->second : TokenType::IDENTIFIER;
+    // Interna o nome direto do fonte; palavras-chave têm IDs fixos
+    Symbol symbol = names.intern(std::string_view(source).substr(start, current - start));
+    bool keyword = symbol >= sym::COMPONENT && symbol < sym::KEYWORDS_END;
+    TokenType type = keyword ? keywords[symbol - sym::COMPONENT] : TokenType::IDENTIFIER;
     
-    addToken(type);
+    addToken(type, std::string());  // O texto fica na tabela de nomes
+    tokens.back().symbol = symbol;
 }
 
 void Lexer::color() {
@@ -175,10 +223,12 @@ void Lexer::color() {
 }
 
 bool Lexer::isAtEnd() {
+    touch(current + 1);
     return current >= source.length();
 }
 
 char Lexer::advance() {
+    touch(current + 1);
     return source[current++];
 }
 
@@ -194,6 +244,7 @@ char Lexer::peek() {
 }
 
 char Lexer::peekNext() {
+    touch(current + 2);
     if (current + 1 >= source.length()) return '\0';
     return source[current + 1];
 }
@@ -204,20 +255,323 @@ void Lexer::addToken(TokenType type) {
 
 void Lexer::addToken(TokenType type, std::string lexeme) {
     tokens.emplace_back(type, std::move(lexeme), line);
+    tokens.back().start = start;
+    tokens.back().end = current;
+    scanEnds.push_back(furthest);
+}
+
+int Lexer::unicodeIdentifierChar(int pos, bool start) {
+    if (pos >= static_cast<int>(source.length()) || !(classOf(source[pos]) & CHAR_NON_ASCII)) return 0;
+    
+    std::uint32_t cp;
+    int size = decodeUtf8(source.data() + pos, source.length() - pos, cp);
+    touch(pos + 4);  // A decodificação examina até 4 bytes
+    if (size == 0) return 0;
+    
+    return (start ? isXidStart(cp) : isXidContinue(cp)) ? size : 0;
+}
+
+std::string Lexer::describeChar(int pos) {
+    std::uint32_t cp;
+    int size = decodeUtf8(source.data() + pos, source.length() - pos, cp);
+    if (size > 0) return source.substr(pos, size);
+    
+    static const char digits[] = "0123456789ABCDEF";
+    unsigned char byte = static_cast<unsigned char>(source[pos]);
+    return std::string("\\x") + digits[byte >> 4] + digits[byte & 0xf];
 }
 
 bool Lexer::isDigit(char c) {
-    return c >= '0' && c <= '9';
+    return classOf(c) & CHAR_DIGIT;
 }
 
 bool Lexer::isAlpha(char c) {
-    return (c >= 'a' && c <= 'z') ||
-           (c >= 'A' && c <= 'Z') ||
-           c == '_';
+    return classOf(c) & CHAR_ALPHA;
 }
 
 bool Lexer::isAlphaNumeric(char c) {
-    return isAlpha(c) || isDigit(c);
+    return classOf(c) & (CHAR_ALPHA | CHAR_DIGIT);
+}
+
+// Implementação do lexer incremental
+// Tamanho mínimo da tabela de nomes antes de compactar
+static const size_t minimumCompaction = 4096;
+
+// Tokens por bloco. Uma edição reescreve poucos blocos e só desloca a base dos
+// demais, então o custo cresce com o número de blocos e não com o de tokens.
+static const size_t chunkSize = 512;
+
+void IncrementalLexer::Chunk::push(Token token, int scanEnd) {
+    token.start -= offset;
+    token.end -= offset;
+    token.line -= line;
+    tokens.push_back(std::move(token));
+    scanEnds.push_back(scanEnd - offset);
+}
+
+Token IncrementalLexer::Chunk::take(size_t i) {
+    Token token = std::move(tokens[i]);
+    token.start += offset;
+    token.end += offset;
+    token.line += line;
+    return token;
+}
+
+IncrementalLexer::IncrementalLexer(std::string source)
+    : text(std::move(source)), interner(std::make_unique<Interner>()), compactAt(minimumCompaction) {
+    rescanAll();
+}
+
+const std::vector<Token>& IncrementalLexer::tokens() const {
+    if (!flatValid) {
+        flat.clear();
+        flat.reserve(count);
+        for (const Chunk& chunk : chunks) {
+            for (const Token& token : chunk.tokens) {
+                flat.push_back(token);
+                flat.back().start += chunk.offset;
+                flat.back().end += chunk.offset;
+                flat.back().line += chunk.line;
+            }
+        }
+        flatValid = true;
+    }
+    return flat;
+}
+
+TokenDelta IncrementalLexer::rescanAll() {
+    TokenDelta delta;
+    delta.removed = count;
+    valid = false;
+    
+    Lexer lexer(std::move(text), *interner);
+    try {
+        lexer.scanTokens();
+    } catch (...) {
+        text = std::move(lexer.source);
+        throw;
+    }
+    text = std::move(lexer.source);
+    
+    delta.inserted = lexer.tokens;
+    chunks.clear();
+    for (size_t i = 0; i < lexer.tokens.size(); i++) {
+        if (i % chunkSize == 0) chunks.emplace_back();
+        chunks.back().push(std::move(lexer.tokens[i]), lexer.scanEnds[i]);
+    }
+    count = delta.inserted.size();
+    flatValid = false;
+    valid = true;
+    return delta;
+}
+
+TokenDelta IncrementalLexer::applyEdit(const TextEdit& edit) {
+    if (edit.start < 0 || edit.end < edit.start || edit.end > static_cast<int>(text.length())) {
+        throw std::runtime_error("Edição fora dos limites do arquivo");
+    }
+    
+    text.replace(edit.start, edit.end - edit.start, edit.replacement);
+    
+    // Depois de uma falha não há fluxo confiável para reaproveitar
+    TokenDelta delta = valid ? rescanFrom(edit) : rescanAll();
+    compactNames(delta);
+    return delta;
+}
+
+// Reescaneia a partir da região danificada pela edição (já aplicada ao fonte)
+TokenDelta IncrementalLexer::rescanFrom(const TextEdit& edit) {
+    const int shift = static_cast<int>(edit.replacement.length()) - (edit.end - edit.start);
+    const int editEnd = edit.start + static_cast<int>(edit.replacement.length());
+    
+    // Primeiro token cujo scan examinou algum byte a partir do início da edição
+    // (inclui o lookahead, ex.: "12p" que tenta ler uma unidade e recua).
+    // scanEnds é crescente no fluxo inteiro: busca o bloco e depois o token.
+    size_t first = std::partition_point(chunks.begin(), chunks.end(), [&](const Chunk& chunk) {
+        return chunk.scanEnd(chunk.scanEnds.size() - 1) <= edit.start;
+    }) - chunks.begin();
+    const Chunk& damaged = chunks[first];
+    size_t index = std::upper_bound(damaged.scanEnds.begin(), damaged.scanEnds.end(),
+                                    edit.start - damaged.offset) - damaged.scanEnds.begin();
+    
+    TokenDelta delta;
+    delta.shift = shift;
+    for (size_t c = 0; c < first; c++) delta.first += chunks[c].tokens.size();
+    delta.first += index;
+    
+    // Retoma exatamente do estado do lexer após o último token intacto
+    Lexer lexer(std::move(text), *interner);
+    if (delta.first > 0) {
+        const Chunk& chunk = index > 0 ? chunks[first] : chunks[first - 1];
+        size_t last = index > 0 ? index - 1 : chunk.tokens.size() - 1;
+        lexer.current = chunk.offset + chunk.tokens[last].end;
+        lexer.line = chunk.line + chunk.tokens[last].line;
+        lexer.furthest = chunk.scanEnd(last);
+    }
+    
+    // Cursor no fluxo antigo: primeiro token ainda não descartado.
+    // O EOF nunca serve de ponto de ressincronização.
+    size_t oldChunk = first;
+    size_t old = index;
+    auto atEof = [&] { return oldChunk == chunks.size() - 1 && old == chunks[oldChunk].tokens.size() - 1; };
+    bool resynced = false;
+    
+    try {
+        while (!lexer.isAtEnd()) {
+            lexer.start = lexer.current;
+            size_t before = lexer.tokens.size();
+            lexer.scanToken();
+            if (lexer.tokens.size() == before) continue;
+            
+            // Só há ressincronização depois da região editada: se um token novo
+            // começa onde começava um token antigo, o restante do fluxo é idêntico
+            const Token& token = lexer.tokens.back();
+            if (token.start < editEnd) continue;
+            
+            int oldStart = token.start - shift;
+            while (!atEof() && chunks[oldChunk].start(old) < oldStart) {
+                delta.removed++;
+                if (++old == chunks[oldChunk].tokens.size()) {
+                    oldChunk++;
+                    old = 0;
+                }
+            }
+            if (!atEof() && chunks[oldChunk].start(old) == oldStart) {
+                resynced = true;
+                delta.lineShift = token.line - (chunks[oldChunk].line + chunks[oldChunk].tokens[old].line);
+                lexer.tokens.pop_back();
+                lexer.scanEnds.pop_back();
+                break;
+            }
+        }
+    } catch (...) {
+        text = std::move(lexer.source);
+        valid = false;
+        throw;
+    }
+    
+    if (!resynced) {
+        lexer.tokens.emplace_back(TokenType::EOF_TOKEN, "", lexer.line);
+        lexer.tokens.back().start = lexer.tokens.back().end = static_cast<int>(lexer.source.length());
+        lexer.scanEnds.push_back(static_cast<int>(lexer.source.length()) + 1);
+        
+        // Nada é reaproveitado: descarta até o fim, inclusive o EOF antigo
+        delta.removed = count - delta.first;
+        oldChunk = chunks.size() - 1;
+        old = chunks[oldChunk].tokens.size();
+    }
+    text = std::move(lexer.source);
+    
+    // Os blocos [first, oldChunk] viram um só: o começo intacto do primeiro,
+    // os tokens novos e o restante do último, deslocado
+    Chunk merged;
+    merged.offset = chunks[first].offset;
+    merged.line = chunks[first].line;
+    merged.tokens.assign(std::make_move_iterator(chunks[first].tokens.begin()),
+                         std::make_move_iterator(chunks[first].tokens.begin() + index));
+    merged.scanEnds.assign(chunks[first].scanEnds.begin(), chunks[first].scanEnds.begin() + index);
+    for (size_t i = 0; i < lexer.tokens.size(); i++) {
+        merged.push(lexer.tokens[i], lexer.scanEnds[i]);
+    }
+    size_t reused = merged.tokens.size();
+    
+    Chunk& rest = chunks[oldChunk];
+    for (size_t i = old; i < rest.tokens.size(); i++) {
+        Token token = rest.take(i);
+        token.start += shift;
+        token.end += shift;
+        token.line += delta.lineShift;
+        merged.push(std::move(token), rest.scanEnd(i) + shift);
+    }
+    
+    // Os blocos seguintes só têm a base deslocada
+    for (size_t c = oldChunk + 1; c < chunks.size(); c++) {
+        chunks[c].offset += shift;
+        chunks[c].line += delta.lineShift;
+    }
+    chunks.erase(chunks.begin() + first + 1, chunks.begin() + oldChunk + 1);
+    chunks[first] = std::move(merged);
+    
+    // scanEnds precisa continuar crescente para a busca binária acima; só os
+    // primeiros tokens reaproveitados podem ter ficado para trás
+    if (reused > 0) {
+        int limit = chunks[first].scanEnd(reused - 1);
+        size_t i = reused;
+        for (size_t c = first; c < chunks.size(); c++, i = 0) {
+            Chunk& chunk = chunks[c];
+            while (i < chunk.tokens.size() && chunk.scanEnd(i) < limit) {
+                chunk.scanEnds[i++] = limit - chunk.offset;
+            }
+            if (i < chunk.tokens.size()) break;
+        }
+    }
+    rebalance(first);
+    
+    count += lexer.tokens.size();
+    count -= delta.removed;
+    flatValid = false;
+    
+    delta.inserted = std::move(lexer.tokens);
+    return delta;
+}
+
+// Mantém o bloco entre chunkSize / 4 e 2 * chunkSize tokens: junta com o
+// seguinte se ficou pequeno e divide em partes iguais se ficou grande
+void IncrementalLexer::rebalance(size_t index) {
+    if (chunks[index].tokens.size() < chunkSize / 4 && index + 1 < chunks.size()) {
+        Chunk& next = chunks[index + 1];
+        for (size_t i = 0; i < next.tokens.size(); i++) {
+            int scanEnd = next.scanEnd(i);
+            chunks[index].push(next.take(i), scanEnd);
+        }
+        chunks.erase(chunks.begin() + index + 1);
+    }
+    
+    size_t size = chunks[index].tokens.size();
+    if (size <= 2 * chunkSize) return;
+    
+    size_t parts = (size + chunkSize - 1) / chunkSize;
+    size_t part = (size + parts - 1) / parts;
+    std::vector<Chunk> pieces;
+    for (size_t from = part; from < size; from += part) {
+        const Chunk& whole = chunks[index];
+        size_t to = std::min(size, from + part);
+        Chunk piece;
+        piece.offset = whole.offset;
+        piece.line = whole.line;
+        piece.tokens.assign(std::make_move_iterator(whole.tokens.begin() + from),
+                            std::make_move_iterator(whole.tokens.begin() + to));
+        piece.scanEnds.assign(whole.scanEnds.begin() + from, whole.scanEnds.begin() + to);
+        pieces.push_back(std::move(piece));
+    }
+    chunks[index].tokens.erase(chunks[index].tokens.begin() + part, chunks[index].tokens.end());
+    chunks[index].scanEnds.resize(part);
+    chunks.insert(chunks.begin() + index + 1, std::make_move_iterator(pieces.begin()),
+                  std::make_move_iterator(pieces.end()));
+}
+
+// A tabela só cresce; sem compactar, uma sessão longa acumularia todo nome
+// já digitado. Quando ela dobra de tamanho, é refeita só com os nomes ainda
+// presentes no fluxo.
+void IncrementalLexer::compactNames(TokenDelta& delta) {
+    if (interner->size() < compactAt) return;
+    
+    auto fresh = std::make_unique<Interner>();
+    for (Chunk& chunk : chunks) {
+        for (Token& token : chunk.tokens) {
+            if (token.symbol >= sym::PREDEFINED_END) {
+                token.symbol = fresh->intern(interner->name(token.symbol));
+            }
+        }
+    }
+    interner = std::move(fresh);
+    compactAt = std::max(minimumCompaction, 2 * interner->size());
+    flatValid = false;
+    
+    // Os símbolos mudaram: a diferença passa a cobrir o fluxo inteiro
+    delta.removed = count - delta.inserted.size() + delta.removed;
+    delta.first = 0;
+    delta.inserted = tokens();
+    delta.shift = delta.lineShift = 0;
 }
 
-} // namespace zyra 
\ No newline at end of file
+} // namespace zyra
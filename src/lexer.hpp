@@ -1,6 +1,8 @@
 #ifndef ZYRA_LEXER_H
 #define ZYRA_LEXER_H
 
+#include "interner.hpp"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -45,25 +47,61 @@ enum class TokenType {
 // Estrutura para representar um token
 struct Token {
     TokenType type;
-    std::string lexeme;  // O texto do token
+    std::string lexeme;  // O texto do token (vazio quando há símbolo)
     int line;           // Linha onde o token aparece
+    int start = 0;      // Offset (em bytes) do início do token no fonte
+    int end = 0;        // Offset (em bytes) logo após o fim do token
+    Symbol symbol = sym::NONE;  // Nome internado (identificadores e palavras-chave)
     
     Token(TokenType t, std::string l, int ln) 
         : type(t), lexeme(std::move(l)), line(ln) {}
+    
+    // Texto do token; o nome de identificadores e palavras-chave vem da
+    // tabela usada pelo Lexer que o produziu
+    const std::string& text(const Interner& names) const {
+        return symbol != sym::NONE ? names.name(symbol) : lexeme;
+    }
+};
+
+// Edição de texto: substitui os bytes [start, end) do fonte por 'replacement'
+struct TextEdit {
+    int start;
+    int end;
+    std::string replacement;
+};
+
+// Diferença no fluxo de tokens causada por uma edição.
+// Os tokens antigos [first, first + removed) são trocados por 'inserted';
+// os tokens seguintes são mantidos, com start/end deslocados por 'shift'
+// bytes e a linha por 'lineShift'.
+struct TokenDelta {
+    size_t first = 0;
+    size_t removed = 0;
+    std::vector<Token> inserted;
+    int shift = 0;
+    int lineShift = 0;
 };
 
 // Classe do analisador léxico
 class Lexer {
 public:
-    explicit Lexer(std::string source);
+    // Os nomes são registrados em 'names' (por padrão, a tabela atual)
+    explicit Lexer(std::string source, Interner& names = Interner::current());
     std::vector<Token> scanTokens();
 
 private:
+    friend class IncrementalLexer;
+    
     std::string source;
+    Interner& names;
     std::vector<Token> tokens;
+    std::vector<int> scanEnds;  // Por token: limite do que foi examinado para produzi-lo
     int start = 0;      // Início do token atual
     int current = 0;    // Caractere atual
     int line = 1;       // Linha atual
+    int furthest = 0;   // Posição mais distante já examinada (lookahead incluso)
+    
+    void touch(int pos) { if (pos > furthest) furthest = pos; }
     
     bool isAtEnd();
     void scanToken();
@@ -80,11 +118,75 @@ private:
     void color();       // Processa cores
     void unit();        // Processa unidades
     
+    // Tamanho em bytes do caractere não-ASCII em 'pos' se ele puder iniciar
+    // (start) ou continuar um identificador; 0 caso contrário
+    int unicodeIdentifierChar(int pos, bool start);
+    std::string describeChar(int pos);  // Caractere em 'pos', para mensagens de erro
+    
     static bool isDigit(char c);
     static bool isAlpha(char c);
     static bool isAlphaNumeric(char c);
 };
 
+// Lexer incremental para integração com editores/language server.
+// Mantém o fonte e o fluxo de tokens; a cada edição reescaneia apenas a
+// região danificada até o fluxo voltar a coincidir com o anterior.
+// Os tokens ficam em blocos com posições relativas à base do bloco: uma
+// edição reescreve só os blocos da região e desloca a base dos seguintes,
+// sem tocar nos seus tokens.
+// Os nomes ficam numa tabela própria da sessão, compactada quando acumula
+// nomes que já não aparecem no fonte (ex.: prefixos digitados no caminho).
+class IncrementalLexer {
+public:
+    explicit IncrementalLexer(std::string source);
+    
+    // Aplica a edição e retorna a diferença no fluxo de tokens.
+    // Se a tabela de nomes for compactada, os símbolos mudam e a diferença
+    // cobre o fluxo inteiro. Se lançar (ex.: string não terminada), o fluxo
+    // continua o da última edição bem-sucedida e a próxima diferença parte dele.
+    TokenDelta applyEdit(const TextEdit& edit);
+    
+    // Fluxo completo, montado a partir dos blocos quando pedido depois de uma
+    // edição (custo proporcional ao arquivo; editores devem preferir o delta)
+    const std::vector<Token>& tokens() const;
+    const std::string& source() const { return text; }
+    
+    // Tabela que resolve os símbolos de tokens()
+    const Interner& names() const { return *interner; }
+
+private:
+    // Tokens consecutivos; start, end, line e scanEnds relativos à base
+    struct Chunk {
+        int offset = 0;  // Base de start, end e scanEnds
+        int line = 0;    // Base de line
+        std::vector<Token> tokens;
+        std::vector<int> scanEnds;  // Limite do que foi examinado por token
+        
+        int start(size_t i) const { return offset + tokens[i].start; }
+        int scanEnd(size_t i) const { return offset + scanEnds[i]; }
+        
+        // Acrescenta um token dado em posições absolutas
+        void push(Token token, int scanEnd);
+        // Retira o token i em posições absolutas
+        Token take(size_t i);
+    };
+    
+    std::string text;
+    std::vector<Chunk> chunks;
+    size_t count = 0;  // Total de tokens
+    bool valid = false;  // Falso se o último scan falhou (ex.: string não terminada)
+    std::unique_ptr<Interner> interner;
+    size_t compactAt = 0;  // Tamanho da tabela que dispara a próxima compactação
+    
+    mutable std::vector<Token> flat;  // Cache de tokens()
+    mutable bool flatValid = false;
+    
+    TokenDelta rescanAll();
+    TokenDelta rescanFrom(const TextEdit& edit);
+    void rebalance(size_t index);
+    void compactNames(TokenDelta& delta);
+};
+
 } // namespace zyra
 
 #endif 
\ No newline at end of file
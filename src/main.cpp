@@ -1,5 +1,8 @@
 #include "lexer.hpp"
 #include "interpreter.hpp"
+#include "server.hpp"
+#include "site.hpp"
+#include <iomanip>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -47,30 +50,123 @@ std::string tokenTypeToString(zyra::TokenType type) {
     }
 }
 
+void printWriteStats(const zyra::WriteStats& stats) {
+    std::cout << stats.written << " arquivo(s) gravado(s), "
+              << stats.unchanged << " sem alterações";
+    if (stats.removed > 0) std::cout << ", " << stats.removed << " antigo(s) removido(s)";
+    std::cout << "." << std::endl;
+}
+
+void printDceReport(const std::vector<zyra::DceReport>& reports) {
+    std::cout << std::left << std::setw(24) << "Componente" << std::right
+              << std::setw(10) << "Antes" << std::setw(10) << "Depois" << std::setw(11) << "Economia"
+              << std::setw(8) << "Estado" << std::setw(10) << "Eventos" << std::setw(9) << "Estilos" << std::endl;
+    for (const auto& report : reports) {
+        std::cout << std::left << std::setw(24) << report.component << std::right
+                  << std::setw(10) << report.bytesBefore << std::setw(10) << report.bytesAfter
+                  << std::setw(10) << report.bytesBefore - report.bytesAfter
+                  << std::setw(8) << report.removedState << std::setw(10) << report.removedEvents
+                  << std::setw(9) << report.removedStyles << std::endl;
+    }
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Uso: " << program << " [opções] <arquivo.zy | pasta>" << std::endl;
+    std::cerr << "     " << program << " serve [opções] <arquivo.zy> [porta]" << std::endl;
+    std::cerr << "  --sw          Gera um service worker com pré-cache dos arquivos" << std::endl;
+    std::cerr << "  --no-dce      Mantém estado, eventos e estilos não usados" << std::endl;
+    std::cerr << "  --dce-report  Mostra os bytes economizados por componente" << std::endl;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Uso: " << argv[0] << " <arquivo.zy>" << std::endl;
+    zyra::BuildOptions options;
+    std::vector<std::string> positional;
+    bool dceReport = false;
+    
+    int first = 1;
+    bool serve = argc > 1 && std::string(argv[1]) == "serve";
+    if (serve) first++;
+    
+    for (int i = first; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--sw") {
+            options.serviceWorker = true;
+        } else if (arg == "--no-dce") {
+            options.eliminateDeadCode = false;
+        } else if (arg == "--dce-report") {
+            dceReport = true;
+        } else if (arg.rfind("--", 0) != 0) {
+            positional.push_back(arg);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (positional.empty() || positional.size() > (serve ? 2u : 1u)) {
+        printUsage(argv[0]);
         return 1;
     }
+    const std::string& inputPath = positional[0];
+    
+    if (serve) {
+        try {
+            int port = positional.size() > 1 ? std::stoi(positional[1]) : 8080;
+            zyra::DevServer server(inputPath, port, options);
+            server.run();
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Erro: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (std::filesystem::is_directory(inputPath)) {
+        try {
+            // Site com várias páginas: uma entrada HTML por página
+            zyra::SiteBuilder site(inputPath, options);
+            auto stats = zyra::writeArtifacts("dist", site.build());
+            
+            std::cout << "Site gerado com sucesso na pasta 'dist'!" << std::endl;
+            printWriteStats(stats);
+            std::cout << std::left << std::setw(31) << "Página" << std::right
+                      << std::setw(12) << "Componentes" << std::setw(12) << "Bytes" << std::endl;
+            for (const auto& page : site.report()) {
+                std::cout << std::left << std::setw(30) << page.page << std::right
+                          << std::setw(12) << page.components << std::setw(12) << page.bytes << std::endl;
+            }
+            if (dceReport) printDceReport(site.dceReport());
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Erro: " << e.what() << std::endl;
+            return 1;
+        }
+    }
     
     try {
         // Lê o arquivo fonte
-        std::string source = readFile(argv[1]);
+        std::string source = readFile(inputPath);
+        
+        // Tabela de nomes usada pelo lexer e pelo gerador
+        zyra::Interner names;
+        zyra::InternerScope scope(names);
         
         // Cria o lexer e gera os tokens
         zyra::Lexer lexer(source);
         auto tokens = lexer.scanTokens();
         
         // Cria o interpretador e gera os arquivos
-        zyra::Interpreter interpreter(tokens);
+        zyra::Interpreter interpreter(tokens, options);
         
         // Cria o diretório dist se não existir
         std::filesystem::create_directories("dist");
         
         // Gera os arquivos HTML/JS
-        interpreter.generate("dist");
+        auto stats = interpreter.generate("dist");
         
         std::cout << "Site gerado com sucesso na pasta 'dist'!" << std::endl;
+        printWriteStats(stats);
+        if (dceReport) printDceReport(interpreter.dceReport());
         std::cout << "Para visualizar, abra o arquivo dist/index.html no navegador." << std::endl;
         
         return 0;
@@ -0,0 +1,118 @@
+#include "optimizer.hpp"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace zyra {
+
+// Tamanho total do que o componente gera
+static size_t generatedSize(Component& component) {
+    return component.generateHTML().length() + component.generateJS().length();
+}
+
+DceReport eliminateDeadCode(Component& component) {
+    DceReport report;
+    report.component = component.name;
+    report.bytesBefore = generatedSize(component);
+    
+    // Raízes: o que a interface lê e chama
+    std::unordered_set<Symbol> liveState;
+    std::vector<Symbol> pending;
+    
+    for (const auto& child : component.children) {
+        if (auto* interface = dynamic_cast<Interface*>(child.get())) {
+            liveState.insert(interface->reads.begin(), interface->reads.end());
+            pending.insert(pending.end(), interface->actions.begin(), interface->actions.end());
+        }
+    }
+    
+    std::unordered_map<Symbol, Event*> events;
+    for (const auto& child : component.children) {
+        if (auto* event = dynamic_cast<Event*>(child.get())) events.emplace(event->name, event);
+    }
+    
+    // Propaga pelos eventos alcançados: um identificador no código pode ser
+    // outro evento (chamada) ou estado
+    std::unordered_set<Symbol> liveEvents;
+    while (!pending.empty()) {
+        Symbol name = pending.back();
+        pending.pop_back();
+        
+        auto it = events.find(name);
+        if (it == events.end() || !liveEvents.insert(name).second) continue;
+        
+        for (Symbol reference : it->second->references()) {
+            if (events.count(reference)) pending.push_back(reference);
+            else liveState.insert(reference);
+        }
+    }
+    
+    // Remove o que não foi alcançado
+    auto& children = component.children;
+    for (auto& child : children) {
+        if (auto* state = dynamic_cast<State*>(child.get())) {
+            auto& variables = state->variables;
+            size_t before = variables.size();
+            variables.erase(std::remove_if(variables.begin(), variables.end(),
+                [&](const auto& var) { return !liveState.count(var.first); }), variables.end());
+            report.removedState += before - variables.size();
+        } else if (auto* style = dynamic_cast<Style*>(child.get())) {
+            // Em propriedades repetidas só a última vale
+            auto& properties = style->properties;
+            std::unordered_set<Symbol> seen;
+            std::vector<std::pair<Symbol, std::string>> kept;
+            for (auto it = properties.rbegin(); it != properties.rend(); ++it) {
+                if (seen.insert(it->first).second) kept.push_back(std::move(*it));
+            }
+            std::reverse(kept.begin(), kept.end());
+            report.removedStyles += properties.size() - kept.size();
+            properties = std::move(kept);
+        }
+    }
+    
+    children.erase(std::remove_if(children.begin(), children.end(), [&](const std::unique_ptr<Node>& child) {
+        if (auto* event = dynamic_cast<Event*>(child.get())) {
+            if (liveEvents.count(event->name)) return false;
+            report.removedEvents++;
+            return true;
+        }
+        if (auto* state = dynamic_cast<State*>(child.get())) {
+            return state->variables.empty();  // O init() do runtime já basta
+        }
+        if (auto* style = dynamic_cast<Style*>(child.get())) {
+            return style->properties.empty() && !style->buttonRules;
+        }
+        return false;
+    }), children.end());
+    
+    report.bytesAfter = generatedSize(component);
+    return report;
+}
+
+void eliminateButtonRules(const std::vector<Component*>& components, std::vector<DceReport>& reports) {
+    for (Component* component : components) {
+        auto references = component->references();
+        if (std::count(references.begin(), references.end(), sym::BOTAO) > 0) return;
+    }
+    
+    for (Component* component : components) {
+        size_t removed = 0;
+        auto& children = component->children;
+        children.erase(std::remove_if(children.begin(), children.end(), [&](const std::unique_ptr<Node>& child) {
+            auto* style = dynamic_cast<Style*>(child.get());
+            if (!style || !style->buttonRules) return false;
+            style->buttonRules = false;
+            removed++;
+            return style->properties.empty();
+        }), children.end());
+        if (removed == 0) continue;
+        
+        for (auto& report : reports) {
+            if (report.component != component->name) continue;
+            report.removedStyles += removed;
+            report.bytesAfter = generatedSize(*component);
+        }
+    }
+}
+
+} // namespace zyra
@@ -0,0 +1,24 @@
+#ifndef ZYRA_OPTIMIZER_H
+#define ZYRA_OPTIMIZER_H
+
+#include "interpreter.hpp"
+
+namespace zyra {
+
+// Eliminação de código morto em um componente.
+// Monta o grafo de referências a partir da interface: os textos (texto,
+// ${...}) leem estado e os elementos chamam eventos (acao); cada evento
+// alcançado pode ler estado e chamar outros eventos. Estado e eventos fora
+// desse grafo são removidos, assim como propriedades de estilo sobrescritas.
+// Isso só vale porque o runtime restringe eventos e bindings ao elemento do
+// próprio componente.
+DceReport eliminateDeadCode(Component& component);
+
+// Remove as regras básicas de botão. O seletor 'button' não é restrito ao
+// componente e estiliza os botões da página inteira, então as regras só saem
+// quando nenhum componente do build tem botões. Atualiza os relatórios.
+void eliminateButtonRules(const std::vector<Component*>& components, std::vector<DceReport>& reports);
+
+} // namespace zyra
+
+#endif
@@ -0,0 +1,154 @@
+#include "output_writer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace zyra {
+
+// Mais threads que isso não ajuda: o gargalo passa a ser o disco
+static const unsigned maxWriterThreads = 4;
+
+OutputWriter::OutputWriter(std::string outputDir, unsigned threads)
+    : outputDir(std::move(outputDir)) {
+    // Cria o diretório de saída se não existir
+    fs::create_directories(this->outputDir);
+    
+    if (threads == 0) {
+        threads = std::min(std::max(std::thread::hardware_concurrency(), 1u), maxWriterThreads);
+    }
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back(&OutputWriter::work, this);
+    }
+}
+
+OutputWriter::~OutputWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    ready.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void OutputWriter::write(Artifact artifact) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        paths.insert(artifact.path);
+        queue.push_back(std::move(artifact));
+        pending++;
+    }
+    ready.notify_one();
+}
+
+WriteStats OutputWriter::finish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return pending == 0; });
+    
+    if (error) {
+        std::exception_ptr failure = error;
+        error = nullptr;
+        std::rethrow_exception(failure);
+    }
+    stats.removed += removeStale();
+    return stats;
+}
+
+// Arquivo que um build anterior pode ter gerado e o atual não: os versionados
+// por hash (<prefixo>.<8 dígitos hex>.js) e o manifesto do service worker
+static bool isRemovable(const std::string& name) {
+    if (name == "precache-manifest.json") return true;
+    for (const char* prefix : {"zyra-runtime.", "zyra-shared."}) {
+        size_t length = std::char_traits<char>::length(prefix);
+        if (name.length() != length + 11 || name.compare(0, length, prefix) != 0) continue;
+        if (name.compare(length + 8, 3, ".js") != 0) return false;
+        return std::all_of(name.begin() + length, name.begin() + length + 8,
+                           [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); });
+    }
+    return false;
+}
+
+// Apaga as versões antigas do runtime e do chunk compartilhado. Como o nome
+// muda a cada alteração, sem isso elas se acumulariam na pasta de saída.
+// Também apaga o manifesto de precache quando o build não tem service worker.
+size_t OutputWriter::removeStale() {
+    size_t removed = 0;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(outputDir, ec)) {
+        std::string name = entry.path().filename().string();
+        if (!isRemovable(name) || paths.count(name)) continue;
+        if (fs::remove(entry.path(), ec)) removed++;
+    }
+    return removed;
+}
+
+void OutputWriter::work() {
+    while (true) {
+        Artifact artifact;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return closing || !queue.empty(); });
+            if (queue.empty()) return;
+            artifact = std::move(queue.front());
+            queue.pop_front();
+        }
+        
+        bool changed = false;
+        std::exception_ptr failure;
+        try {
+            changed = writeIfChanged(artifact);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failure && !error) error = failure;
+        else if (!failure) (changed ? stats.written : stats.unchanged)++;
+        if (--pending == 0) idle.notify_all();
+    }
+}
+
+bool OutputWriter::writeIfChanged(const Artifact& artifact) {
+    fs::path target = fs::path(outputDir) / artifact.path;
+    
+    // Compara com o arquivo existente (o tamanho primeiro, que é barato)
+    std::error_code ec;
+    if (fs::file_size(target, ec) == artifact.content.length() && !ec) {
+        std::ifstream existing(target, std::ios::binary);
+        std::string bytes(artifact.content.length(), '\0');
+        if (existing.read(&bytes[0], bytes.length()) && bytes == artifact.content) {
+            return false;
+        }
+    }
+    
+    if (target.has_parent_path()) fs::create_directories(target.parent_path());
+    
+    // Nome temporário único na mesma pasta (rename só é atômico no mesmo sistema de arquivos)
+    static std::atomic<unsigned> counter{0};
+    fs::path temp = target;
+    temp += ".tmp." + std::to_string(getpid()) + "." + std::to_string(counter++);
+    
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file.write(artifact.content.data(), artifact.content.length());
+        file.close();
+        if (!file) {
+            fs::remove(temp, ec);
+            throw std::runtime_error("Não foi possível gravar " + target.string());
+        }
+    }
+    
+    fs::rename(temp, target, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        throw std::runtime_error("Não foi possível substituir " + target.string());
+    }
+    return true;
+}
+
+} // namespace zyra
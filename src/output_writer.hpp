@@ -0,0 +1,58 @@
+#ifndef ZYRA_OUTPUT_WRITER_H
+#define ZYRA_OUTPUT_WRITER_H
+
+#include "interpreter.hpp"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace zyra {
+
+// Estágio de saída do build: grava os arquivos gerados em threads de fundo.
+// Um arquivo idêntico ao que já está no disco não é reescrito (preserva a
+// data de modificação, evitando uploads e invalidações de cache à toa).
+// Os demais são gravados em um arquivo temporário e movidos com rename(),
+// então quem lê a pasta nunca vê um arquivo pela metade.
+// Ao final, arquivos versionados por hash (zyra-runtime.<hash>.js,
+// zyra-shared.<hash>.js) de builds anteriores são apagados, assim como o
+// precache-manifest.json se o build atual não o gerou.
+class OutputWriter {
+public:
+    explicit OutputWriter(std::string outputDir, unsigned threads = 0);
+    ~OutputWriter();
+    
+    // Enfileira um arquivo para gravação
+    void write(Artifact artifact);
+    
+    // Espera a fila esvaziar e apaga os arquivos versionados que não fazem
+    // parte deste build; relança o primeiro erro de gravação
+    WriteStats finish();
+
+private:
+    std::string outputDir;
+    
+    std::mutex mutex;
+    std::condition_variable ready;  // Há trabalho na fila (ou fim)
+    std::condition_variable idle;   // Todo o trabalho enfileirado terminou
+    std::deque<Artifact> queue;
+    std::unordered_set<std::string> paths;  // Arquivos deste build
+    size_t pending = 0;             // Enfileirados e ainda não concluídos
+    bool closing = false;
+    
+    std::exception_ptr error;
+    WriteStats stats;
+    std::vector<std::thread> workers;
+    
+    void work();
+    bool writeIfChanged(const Artifact& artifact);
+    size_t removeStale();
+};
+
+} // namespace zyra
+
+#endif
@@ -0,0 +1,58 @@
+#include "runtime.hpp"
+#include "hash.hpp"
+
+namespace zyra {
+
+const std::string& runtimeSource() {
+    static const std::string source =
+        "// Zyra runtime: código compartilhado por todos os componentes\n"
+        "class ZyraComponent {\n"
+        "  // root: elemento do componente; as consultas ao DOM ficam restritas a ele\n"
+        "  constructor(root) {\n"
+        "    this.root = root;\n"
+        "    this.bindTemplates();\n"
+        "    this.init();\n"
+        "    this.setupEvents();\n"
+        "  }\n"
+        "\n"
+        "  init() {\n"
+        "    this.updateView();\n"
+        "  }\n"
+        "\n"
+        "  // Sobrescritos pelos componentes com textos interpolados\n"
+        "  bindTemplates() {}\n"
+        "\n"
+        "  updateTemplates() {}\n"
+        "\n"
+        "  setupEvents() {\n"
+        "    // Configura os eventos dos botões\n"
+        "    const buttons = this.root.querySelectorAll('button');\n"
+        "    buttons.forEach(button => {\n"
+        "      const action = button.getAttribute('data-action');\n"
+        "      if (action && typeof this[action] === 'function') {\n"
+        "        button.onclick = () => this[action]();\n"
+        "      }\n"
+        "    });\n"
+        "  }\n"
+        "\n"
+        "  updateView() {\n"
+        "    // Atualiza o texto dos elementos\n"
+        "    const elements = this.root.querySelectorAll('[data-bind]');\n"
+        "    elements.forEach(element => {\n"
+        "      const binding = element.getAttribute('data-bind');\n"
+        "      if (binding && this[binding] !== undefined) {\n"
+        "        element.textContent = this[binding];\n"
+        "      }\n"
+        "    });\n"
+        "    this.updateTemplates();\n"
+        "  }\n"
+        "}\n";
+    return source;
+}
+
+const std::string& runtimeFileName() {
+    static const std::string name = "zyra-runtime." + contentHash(runtimeSource()).substr(0, 8) + ".js";
+    return name;
+}
+
+} // namespace zyra
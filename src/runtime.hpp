@@ -0,0 +1,18 @@
+#ifndef ZYRA_RUNTIME_H
+#define ZYRA_RUNTIME_H
+
+#include <string>
+
+namespace zyra {
+
+// Runtime JavaScript compartilhado por todos os componentes gerados.
+// Os componentes estendem ZyraComponent em vez de repetir os helpers.
+const std::string& runtimeSource();
+
+// Nome versionado do arquivo do runtime (zyra-runtime.<hash>.js), para
+// que o navegador possa mantê-lo em cache entre páginas e builds
+const std::string& runtimeFileName();
+
+} // namespace zyra
+
+#endif
@@ -0,0 +1,438 @@
+#include "server.hpp"
+#include "hash.hpp"
+#include "service_worker.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace zyra {
+
+static const size_t maxRequestSize = 64 * 1024;
+static const int maxEvents = 256;
+static const int maxIovecs = 64;
+
+static std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+static const char* contentTypeFor(const std::string& path) {
+    auto endsWith = [&](const char* ext) {
+        size_t n = std::strlen(ext);
+        return path.length() >= n && path.compare(path.length() - n, n, ext) == 0;
+    };
+    if (endsWith(".html")) return "text/html; charset=utf-8";
+    if (endsWith(".js")) return "text/javascript; charset=utf-8";
+    if (endsWith(".css")) return "text/css; charset=utf-8";
+    if (endsWith(".json")) return "application/json";
+    return "application/octet-stream";
+}
+
+static bool equalsIgnoreCase(const std::string& a, const char* b) {
+    size_t n = std::strlen(b);
+    if (a.length() != n) return false;
+    for (size_t i = 0; i < n; i++) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != b[i]) return false;
+    }
+    return true;
+}
+
+DevServer::DevServer(std::string sourcePath, int port, BuildOptions options)
+    : sourcePath(std::move(sourcePath)), port(port), options(options) {
+    std::filesystem::path path(this->sourcePath);
+    sourceName = path.filename().string();
+    std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+    
+    // O destrutor não roda se o construtor lançar: fecha aqui o que já abriu
+    try {
+        openDescriptors(directory);
+    } catch (...) {
+        closeDescriptors();
+        throw;
+    }
+}
+
+void DevServer::openDescriptors(const std::string& directory) {
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) throw systemError("Não foi possível criar o socket");
+    
+    int yes = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        throw systemError("Não foi possível usar a porta " + std::to_string(port));
+    }
+    if (listen(listenFd, SOMAXCONN) < 0) throw systemError("Falha em listen");
+    
+    // Observa o diretório, e não o arquivo: editores costumam salvar
+    // gravando um arquivo temporário e renomeando por cima do original
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd < 0) throw systemError("Falha ao iniciar o inotify");
+    if (inotify_add_watch(watchFd, directory.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MODIFY) < 0) {
+        throw systemError("Não foi possível observar " + directory);
+    }
+    
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) throw systemError("Falha ao criar o epoll");
+    
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.fd = watchFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, watchFd, &event);
+}
+
+DevServer::~DevServer() {
+    for (const auto& entry : connections) close(entry.first);
+    closeDescriptors();
+}
+
+void DevServer::closeDescriptors() {
+    if (epollFd >= 0) close(epollFd);
+    if (watchFd >= 0) close(watchFd);
+    if (listenFd >= 0) close(listenFd);
+    epollFd = watchFd = listenFd = -1;
+}
+
+void DevServer::run() {
+    std::cout << "Servidor Zyra em http://127.0.0.1:" << port << "/ (fonte: " << sourcePath << ")" << std::endl;
+    
+    epoll_event events[maxEvents];
+    while (true) {
+        int count = epoll_wait(epollFd, events, maxEvents, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("Falha em epoll_wait");
+        }
+        
+        for (int i = 0; i < count; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptConnections();
+            } else if (fd == watchFd) {
+                readWatcher();
+            } else if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeConnection(fd);
+            } else {
+                if (events[i].events & EPOLLIN) readFrom(fd);
+                if ((events[i].events & EPOLLOUT) && connections.count(fd)) writeTo(fd);
+            }
+        }
+    }
+}
+
+std::shared_ptr<const DevServer::Build> DevServer::currentBuild() {
+    if (!cache) cache = compile();
+    return cache;
+}
+
+std::shared_ptr<const DevServer::Build> DevServer::compile() {
+    auto build = std::make_shared<Build>();
+    try {
+        std::ifstream file(sourcePath);
+        if (!file.is_open()) {
+            throw std::runtime_error("Não foi possível abrir o arquivo: " + sourcePath);
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        
+        // Cada recompilação usa uma tabela de nomes nova; a anterior é
+        // descartada, então o servidor não acumula nomes entre edições
+        Interner names;
+        InternerScope scope(names);
+        Lexer lexer(buffer.str());
+        Interpreter interpreter(lexer.scanTokens(), options);
+        auto artifacts = interpreter.build();
+        
+        // Sem --sw, /sw.js desinstala um worker registrado numa sessão anterior
+        // (em localhost ele continuaria servindo as páginas antigas)
+        if (!options.serviceWorker) retireServiceWorker(artifacts);
+        
+        for (auto& artifact : artifacts) {
+            Asset asset;
+            asset.etag = "\"" + contentHash(artifact.content) + "\"";
+            asset.contentType = contentTypeFor(artifact.path);
+            asset.content = std::move(artifact.content);
+            build->assets.emplace("/" + artifact.path, std::move(asset));
+        }
+        std::cout << "Compilado " << sourcePath << " (" << build->assets.size() << " arquivos)" << std::endl;
+    } catch (const std::exception& e) {
+        build->assets.clear();
+        build->error = e.what();
+        std::cerr << "Erro: " << e.what() << std::endl;
+    }
+    return build;
+}
+
+void DevServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN: fila vazia (ou limite de descritores)
+        }
+        
+        int yes = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        connections[fd];
+    }
+}
+
+void DevServer::readWatcher() {
+    alignas(inotify_event) char buffer[4096];
+    bool changed = false;
+    
+    while (true) {
+        ssize_t n = read(watchFd, buffer, sizeof(buffer));
+        if (n <= 0) break;
+        for (char* p = buffer; p < buffer + n;) {
+            auto* event = reinterpret_cast<inotify_event*>(p);
+            if (event->len > 0 && sourceName == event->name) changed = true;
+            p += sizeof(inotify_event) + event->len;
+        }
+    }
+    
+    // Só descarta o cache; a recompilação acontece na próxima requisição
+    if (changed) cache.reset();
+}
+
+void DevServer::readFrom(int fd) {
+    Connection& conn = connections[fd];
+    char buffer[16 * 1024];
+    bool peerClosed = false;
+    
+    while (true) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            conn.input.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n < 0) {
+            closeConnection(fd);
+            return;
+        }
+        peerClosed = true;  // O cliente pode fechar a escrita e ainda esperar a resposta
+        break;
+    }
+    
+    if (!handleRequests(conn)) {
+        closeConnection(fd);
+        return;
+    }
+    if (peerClosed) conn.closeAfterWrite = true;
+    
+    if (!conn.output.empty()) writeTo(fd);
+    else if (conn.closeAfterWrite) closeConnection(fd);
+}
+
+bool DevServer::handleRequests(Connection& conn) {
+    size_t offset = 0;
+    
+    // Processa todas as requisições completas (suporta pipelining)
+    while (!conn.closeAfterWrite) {
+        size_t headerEnd = conn.input.find("\r\n\r\n", offset);
+        if (headerEnd == std::string::npos) break;
+        
+        std::istringstream lines(conn.input.substr(offset, headerEnd - offset));
+        std::string requestLine;
+        std::getline(lines, requestLine);
+        if (!requestLine.empty() && requestLine.back() == '\r') requestLine.pop_back();
+        
+        std::string method, target, version;
+        std::istringstream(requestLine) >> method >> target >> version;
+        if (method.empty() || target.empty() || version.rfind("HTTP/1.", 0) != 0) return false;
+        
+        std::string ifNoneMatch;
+        std::string connectionHeader;
+        size_t contentLength = 0;
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) continue;
+            
+            std::string name = line.substr(0, colon);
+            size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+            std::string value = valueStart == std::string::npos ? "" : line.substr(valueStart);
+            
+            if (equalsIgnoreCase(name, "if-none-match")) ifNoneMatch = value;
+            else if (equalsIgnoreCase(name, "connection")) connectionHeader = value;
+            else if (equalsIgnoreCase(name, "content-length")) contentLength = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        
+        // Corpo (se houver) é ignorado, mas precisa ter chegado por inteiro
+        size_t requestEnd = headerEnd + 4 + contentLength;
+        if (conn.input.length() < requestEnd) break;
+        offset = requestEnd;
+        
+        bool keepAlive = version == "HTTP/1.1" ? !equalsIgnoreCase(connectionHeader, "close")
+                                               : equalsIgnoreCase(connectionHeader, "keep-alive");
+        respond(conn, method, target, ifNoneMatch, keepAlive);
+    }
+    
+    conn.input.erase(0, offset);
+    return conn.input.length() <= maxRequestSize;
+}
+
+void DevServer::respond(Connection& conn, const std::string& method, std::string target,
+                        const std::string& ifNoneMatch, bool keepAlive) {
+    Response response;
+    std::string status;
+    std::string headers;
+    std::string errorBody;
+    
+    size_t query = target.find_first_of("?#");
+    if (query != std::string::npos) target.erase(query);
+    if (!target.empty() && target.back() == '/') target += "index.html";
+    
+    if (method != "GET" && method != "HEAD") {
+        status = "405 Method Not Allowed";
+        headers = "Allow: GET, HEAD\r\n";
+        errorBody = "Método não suportado\n";
+    } else {
+        response.build = currentBuild();
+        auto it = response.build->assets.find(target);
+        
+        if (!response.build->error.empty()) {
+            status = "500 Internal Server Error";
+            errorBody = "Erro de compilação: " + response.build->error + "\n";
+        } else if (it == response.build->assets.end()) {
+            status = "404 Not Found";
+            errorBody = "Arquivo não encontrado: " + target + "\n";
+        } else {
+            const Asset& asset = it->second;
+            headers = "ETag: " + asset.etag + "\r\nCache-Control: no-cache\r\n";
+            
+            bool notModified = ifNoneMatch == "*" || ifNoneMatch.find(asset.etag) != std::string::npos;
+            if (notModified) {
+                status = "304 Not Modified";
+            } else {
+                status = "200 OK";
+                headers += "Content-Type: " + std::string(asset.contentType) + "\r\n";
+                headers += "Content-Length: " + std::to_string(asset.content.length()) + "\r\n";
+                if (method == "GET") response.body = &asset.content;
+            }
+        }
+    }
+    
+    if (!errorBody.empty()) {
+        headers += "Content-Type: text/plain; charset=utf-8\r\n";
+        headers += "Content-Length: " + std::to_string(errorBody.length()) + "\r\n";
+        if (method == "HEAD") errorBody.clear();
+    }
+    
+    if (!keepAlive) {
+        headers += "Connection: close\r\n";
+        conn.closeAfterWrite = true;
+    }
+    
+    response.head = "HTTP/1.1 " + status + "\r\n" + headers + "\r\n" + errorBody;
+    if (!response.body) response.build.reset();
+    conn.output.push_back(std::move(response));
+}
+
+void DevServer::writeTo(int fd) {
+    Connection& conn = connections[fd];
+    
+    while (!conn.output.empty()) {
+        // Junta cabeçalhos e corpos pendentes em uma única chamada
+        iovec iov[maxIovecs];
+        int count = 0;
+        for (const auto& response : conn.output) {
+            if (count + 2 > maxIovecs) break;
+            size_t skip = response.sent;
+            if (skip < response.head.length()) {
+                iov[count].iov_base = const_cast<char*>(response.head.data() + skip);
+                iov[count].iov_len = response.head.length() - skip;
+                count++;
+                skip = 0;
+            } else {
+                skip -= response.head.length();
+            }
+            if (response.body && skip < response.body->length()) {
+                iov[count].iov_base = const_cast<char*>(response.body->data() + skip);
+                iov[count].iov_len = response.body->length() - skip;
+                count++;
+            }
+        }
+        
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = count;
+        ssize_t written = sendmsg(fd, &message, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                setWantWrite(fd, conn, true);
+                return;
+            }
+            closeConnection(fd);
+            return;
+        }
+        
+        // Descarta as respostas enviadas por completo
+        size_t remaining = static_cast<size_t>(written);
+        while (remaining > 0 && !conn.output.empty()) {
+            Response& response = conn.output.front();
+            size_t total = response.head.length() + (response.body ? response.body->length() : 0);
+            size_t step = std::min(remaining, total - response.sent);
+            response.sent += step;
+            remaining -= step;
+            if (response.sent == total) conn.output.pop_front();
+        }
+    }
+    
+    if (conn.closeAfterWrite) {
+        closeConnection(fd);
+        return;
+    }
+    setWantWrite(fd, conn, false);
+}
+
+void DevServer::setWantWrite(int fd, Connection& conn, bool enabled) {
+    if (conn.wantWrite == enabled) return;
+    conn.wantWrite = enabled;
+    
+    epoll_event event{};
+    event.events = EPOLLIN | (enabled ? static_cast<uint32_t>(EPOLLOUT) : static_cast<uint32_t>(0));
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+}
+
+void DevServer::closeConnection(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+}
+
+} // namespace zyra
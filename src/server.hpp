@@ -0,0 +1,86 @@
+#ifndef ZYRA_SERVER_H
+#define ZYRA_SERVER_H
+
+#include "interpreter.hpp"
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace zyra {
+
+// Servidor de desenvolvimento (zyra serve).
+// Servidor HTTP/1.1 baseado em epoll, em uma única thread. Compila o fonte
+// sob demanda e mantém os arquivos gerados em memória até o fonte mudar
+// (detectado via inotify). As respostas saem direto do cache, com ETag e
+// suporte a GET condicional (If-None-Match -> 304).
+class DevServer {
+public:
+    DevServer(std::string sourcePath, int port, BuildOptions options = {});
+    ~DevServer();
+    
+    // Inicia o laço de eventos (não retorna)
+    void run();
+
+private:
+    // Arquivo gerado, pronto para ser servido
+    struct Asset {
+        std::string content;
+        std::string etag;
+        const char* contentType;
+    };
+    
+    // Resultado de uma compilação; imutável depois de criado
+    struct Build {
+        std::unordered_map<std::string, Asset> assets;
+        std::string error;  // Preenchido se a compilação falhou
+    };
+    
+    // Resposta pendente. O corpo aponta para o cache, sem cópia; o
+    // shared_ptr mantém o build vivo mesmo se o fonte mudar no meio do envio
+    struct Response {
+        std::string head;
+        std::shared_ptr<const Build> build;
+        const std::string* body = nullptr;
+        size_t sent = 0;
+    };
+    
+    struct Connection {
+        std::string input;
+        std::deque<Response> output;
+        bool closeAfterWrite = false;
+        bool wantWrite = false;  // EPOLLOUT registrado
+    };
+    
+    std::string sourcePath;
+    std::string sourceName;  // Nome do arquivo dentro do diretório observado
+    int port;
+    BuildOptions options;
+    
+    int listenFd = -1;
+    int epollFd = -1;
+    int watchFd = -1;
+    
+    std::shared_ptr<const Build> cache;
+    std::unordered_map<int, Connection> connections;
+    
+    void openDescriptors(const std::string& directory);
+    void closeDescriptors();
+    
+    std::shared_ptr<const Build> currentBuild();
+    std::shared_ptr<const Build> compile();
+    
+    void acceptConnections();
+    void readWatcher();
+    void readFrom(int fd);
+    void writeTo(int fd);
+    bool handleRequests(Connection& conn);
+    void respond(Connection& conn, const std::string& method, std::string target,
+                 const std::string& ifNoneMatch, bool keepAlive);
+    void setWantWrite(int fd, Connection& conn, bool enabled);
+    void closeConnection(int fd);
+};
+
+} // namespace zyra
+
+#endif
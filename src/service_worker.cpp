@@ -0,0 +1,100 @@
+#include "service_worker.hpp"
+#include "hash.hpp"
+#include <sstream>
+
+namespace zyra {
+
+static const char* const serviceWorkerSource =
+    "const CACHE = 'zyra-precache';\n"
+    "\n"
+    "// Cada revisão tem a própria chave no cache\n"
+    "function cacheKey(entry) {\n"
+    "  return new URL(entry.url + '?__zyra=' + entry.revision, self.registration.scope).href;\n"
+    "}\n"
+    "\n"
+    "const KEYS = new Map(PRECACHE.map(entry =>\n"
+    "  [new URL(entry.url, self.registration.scope).href, cacheKey(entry)]));\n"
+    "\n"
+    "self.addEventListener('install', event => {\n"
+    "  // Baixa apenas as entradas cuja revisão ainda não está no cache\n"
+    "  event.waitUntil(caches.open(CACHE).then(cache =>\n"
+    "    Promise.all(PRECACHE.map(entry => {\n"
+    "      const key = cacheKey(entry);\n"
+    "      return cache.match(key).then(hit => hit ||\n"
+    "        fetch(new URL(entry.url, self.registration.scope), { cache: 'no-cache' }).then(response => {\n"
+    "          if (!response.ok) throw new Error('Falha ao baixar ' + entry.url);\n"
+    "          return cache.put(key, response);\n"
+    "        }));\n"
+    "    }))\n"
+    "  ).then(() => self.skipWaiting()));\n"
+    "});\n"
+    "\n"
+    "self.addEventListener('activate', event => {\n"
+    "  // Remove revisões que não fazem mais parte do build\n"
+    "  const keep = new Set(KEYS.values());\n"
+    "  event.waitUntil(caches.open(CACHE).then(cache =>\n"
+    "    cache.keys().then(requests =>\n"
+    "      Promise.all(requests.filter(request => !keep.has(request.url))\n"
+    "        .map(request => cache.delete(request))))\n"
+    "  ).then(() => self.clients.claim()));\n"
+    "});\n"
+    "\n"
+    "self.addEventListener('fetch', event => {\n"
+    "  if (event.request.method !== 'GET') return;\n"
+    "  const url = new URL(event.request.url);\n"
+    "  url.search = '';\n"
+    "  url.hash = '';\n"
+    "  if (url.pathname.endsWith('/')) url.pathname += 'index.html';\n"
+    "  const key = KEYS.get(url.href);\n"
+    "  if (!key) return;\n"
+    "  event.respondWith(caches.open(CACHE)\n"
+    "    .then(cache => cache.match(key))\n"
+    "    .then(hit => hit || fetch(event.request)));\n"
+    "});\n";
+
+static const char* const retiredWorkerSource =
+    "// Service worker gerado pelo Zyra: o build atual não usa service worker.\n"
+    "// Substitui a versão anterior, apaga o pré-cache e se desregistra.\n"
+    "self.addEventListener('install', () => self.skipWaiting());\n"
+    "\n"
+    "self.addEventListener('activate', event => {\n"
+    "  event.waitUntil(caches.delete('zyra-precache')\n"
+    "    .then(() => self.registration.unregister())\n"
+    "    .then(() => self.clients.matchAll({ type: 'window' }))\n"
+    "    .then(clients => clients.forEach(client => client.navigate(client.url))));\n"
+    "});\n";
+
+void addServiceWorker(std::vector<Artifact>& artifacts) {
+    std::stringstream manifest;
+    manifest << "[\n";
+    for (size_t i = 0; i < artifacts.size(); i++) {
+        manifest << "  { \"url\": \"" << artifacts[i].path << "\", "
+                 << "\"revision\": \"" << contentHash(artifacts[i].content) << "\" }";
+        manifest << (i + 1 < artifacts.size() ? ",\n" : "\n");
+    }
+    manifest << "]";
+    
+    // O manifesto vai embutido no sw.js: qualquer arquivo alterado muda os
+    // bytes do service worker, o que faz o navegador instalar a nova versão
+    std::stringstream sw;
+    sw << "// Service worker gerado pelo Zyra: pré-cache dos arquivos do build\n";
+    sw << "const PRECACHE = " << manifest.str() << ";\n\n";
+    sw << serviceWorkerSource;
+    
+    artifacts.push_back({"precache-manifest.json", manifest.str() + "\n"});
+    artifacts.push_back({"sw.js", sw.str()});
+}
+
+void retireServiceWorker(std::vector<Artifact>& artifacts) {
+    artifacts.push_back({"sw.js", retiredWorkerSource});
+}
+
+std::string serviceWorkerRegistration() {
+    return "<script>\n"
+           "if ('serviceWorker' in navigator) {\n"
+           "  navigator.serviceWorker.register('sw.js');\n"
+           "}\n"
+           "</script>\n";
+}
+
+} // namespace zyra
@@ -0,0 +1,27 @@
+#ifndef ZYRA_SERVICE_WORKER_H
+#define ZYRA_SERVICE_WORKER_H
+
+#include "interpreter.hpp"
+#include <string>
+#include <vector>
+
+namespace zyra {
+
+// Adiciona ao build o manifesto de precache (precache-manifest.json) e o
+// service worker (sw.js) que serve os arquivos listados a partir do cache.
+// Cada entrada leva o hash do conteúdo: após um novo build, só os arquivos
+// cujo hash mudou são baixados de novo.
+void addServiceWorker(std::vector<Artifact>& artifacts);
+
+// Adiciona ao build um sw.js que desfaz um service worker de um build
+// anterior: apaga o cache de pré-cache, se desregistra e recarrega as abas.
+// Sem isso, o worker instalado continuaria servindo as páginas antigas,
+// já que o navegador mantém o worker atual se o sw.js sumir (404).
+void retireServiceWorker(std::vector<Artifact>& artifacts);
+
+// Script que registra o service worker, incluído no HTML
+std::string serviceWorkerRegistration();
+
+} // namespace zyra
+
+#endif
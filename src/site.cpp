@@ -0,0 +1,188 @@
+#include "site.hpp"
+#include "hash.hpp"
+#include "optimizer.hpp"
+#include "runtime.hpp"
+#include "service_worker.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace zyra {
+
+// Lê os componentes de um arquivo .zy
+static std::vector<std::unique_ptr<Component>> parseFile(const fs::path& path, BuildOptions options,
+                                                         std::vector<DceReport>& reports) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível abrir o arquivo: " + path.string());
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    
+    try {
+        Lexer lexer(buffer.str());
+        Interpreter interpreter(lexer.scanTokens(), options);
+        auto components = interpreter.parse();
+        reports.insert(reports.end(), interpreter.dceReport().begin(), interpreter.dceReport().end());
+        return components;
+    } catch (const std::exception& e) {
+        throw std::runtime_error(path.string() + ": " + e.what());
+    }
+}
+
+SiteBuilder::SiteBuilder(std::string root, BuildOptions options)
+    : root(std::move(root)), options(options) {}
+
+std::vector<Artifact> SiteBuilder::build() {
+    pages.clear();
+    reports.clear();
+    
+    // Tabela de nomes própria do build, descartada no fim
+    Interner names;
+    InternerScope scope(names);
+    
+    // Forma normal e sem separador no final ("site/pages/" -> "site/pages"),
+    // para comparar com o diretório de cada arquivo encontrado
+    fs::path rootDir = fs::path(root).lexically_normal();
+    if (!rootDir.has_filename() && rootDir.has_relative_path()) rootDir = rootDir.parent_path();
+    
+    fs::path pagesDir = rootDir / "pages";
+    if (!fs::is_directory(pagesDir)) pagesDir = rootDir;
+    
+    // Separa as páginas dos arquivos que só fornecem componentes
+    std::vector<fs::path> pageFiles;
+    std::vector<fs::path> libraryFiles;
+    for (auto it = fs::recursive_directory_iterator(rootDir); it != fs::recursive_directory_iterator(); ++it) {
+        std::string name = it->path().filename().string();
+        if (it->is_directory() && (name == "dist" || name == "node_modules")) {
+            it.disable_recursion_pending();
+            continue;
+        }
+        if (!it->is_regular_file() || it->path().extension() != ".zy") continue;
+        
+        if (it->path().parent_path() == pagesDir) pageFiles.push_back(it->path());
+        else libraryFiles.push_back(it->path());
+    }
+    std::sort(pageFiles.begin(), pageFiles.end());
+    std::sort(libraryFiles.begin(), libraryFiles.end());
+    
+    if (pageFiles.empty()) {
+        throw std::runtime_error("Nenhuma página (.zy) encontrada em " + pagesDir.string());
+    }
+    
+    // Registro global de componentes, por nome
+    std::vector<std::unique_ptr<Component>> owned;
+    std::unordered_map<std::string, Component*> registry;
+    std::vector<std::vector<Component*>> pageRoots;
+    
+    auto registerFile = [&](const fs::path& path) {
+        std::vector<Component*> declared;
+        for (auto& component : parseFile(path, options, reports)) {
+            if (!registry.emplace(component->name, component.get()).second) {
+                throw std::runtime_error("Componente '" + component->name + "' definido mais de uma vez (" + path.string() + ")");
+            }
+            declared.push_back(component.get());
+            owned.push_back(std::move(component));
+        }
+        return declared;
+    };
+    
+    for (const auto& path : pageFiles) pageRoots.push_back(registerFile(path));
+    for (const auto& path : libraryFiles) registerFile(path);
+    
+    // As regras de botão valem para a página toda: decide com o site inteiro
+    if (options.eliminateDeadCode) {
+        std::vector<Component*> all;
+        for (const auto& component : owned) all.push_back(component.get());
+        eliminateButtonRules(all, reports);
+    }
+    
+    // Componentes de cada página: os declarados nela e tudo que eles usam
+    std::vector<std::vector<Component*>> pageComponents;
+    std::unordered_map<Component*, int> usage;
+    for (const auto& roots : pageRoots) {
+        std::vector<Component*> closure(roots.begin(), roots.end());
+        for (size_t i = 0; i < closure.size(); i++) {
+            for (Symbol reference : closure[i]->references()) {
+                auto it = registry.find(Interner::current().name(reference));
+                if (it == registry.end()) continue;  // Elemento nativo (Botao, Texto...)
+                if (std::find(closure.begin(), closure.end(), it->second) == closure.end()) {
+                    closure.push_back(it->second);
+                }
+            }
+        }
+        for (Component* component : closure) usage[component]++;
+        pageComponents.push_back(std::move(closure));
+    }
+    
+    std::vector<Artifact> artifacts;
+    artifacts.push_back({runtimeFileName(), runtimeSource()});
+    
+    // Componentes usados por mais de uma página vão para o chunk compartilhado;
+    // os exclusivos de uma página saem em arquivos próprios
+    std::unordered_map<Component*, size_t> scriptSizes;
+    std::string shared;
+    for (const auto& closure : pageComponents) {
+        for (Component* component : closure) {
+            if (scriptSizes.count(component)) continue;
+            std::string js = component->generateJS();
+            scriptSizes[component] = js.length();
+            if (usage[component] > 1) shared += js;
+            else artifacts.push_back({component->name + ".js", std::move(js)});
+        }
+    }
+    
+    std::string sharedFileName;
+    if (!shared.empty()) {
+        sharedFileName = "zyra-shared." + contentHash(shared).substr(0, 8) + ".js";
+        artifacts.push_back({sharedFileName, shared});
+    }
+    
+    for (size_t i = 0; i < pageFiles.size(); i++) {
+        std::stringstream body;
+        std::stringstream tags;
+        PageReport report;
+        report.page = pageFiles[i].stem().string() + ".html";
+        report.components = pageComponents[i].size();
+        report.bytes = runtimeSource().length();
+        
+        tags << "<script src=\"" << runtimeFileName() << "\"></script>\n";
+        
+        bool usesShared = false;
+        for (Component* component : pageComponents[i]) {
+            body << component->generateHTML();
+            usesShared = usesShared || usage[component] > 1;
+        }
+        if (usesShared) {
+            tags << "<script src=\"" << sharedFileName << "\"></script>\n";
+            report.bytes += shared.length();
+        }
+        for (Component* component : pageComponents[i]) {
+            if (usage[component] > 1) continue;
+            tags << "<script src=\"" << component->name << ".js\"></script>\n";
+            report.bytes += scriptSizes[component];
+        }
+        
+        if (options.serviceWorker) {
+            tags << serviceWorkerRegistration();
+        }
+        
+        std::string html = pageDocument(pageFiles[i].stem().string(), body.str() + tags.str());
+        report.bytes += html.length();
+        artifacts.push_back({report.page, std::move(html)});
+        pages.push_back(std::move(report));
+    }
+    
+    if (options.serviceWorker) {
+        addServiceWorker(artifacts);
+    }
+    
+    return artifacts;
+}
+
+} // namespace zyra
@@ -0,0 +1,43 @@
+#ifndef ZYRA_SITE_H
+#define ZYRA_SITE_H
+
+#include "interpreter.hpp"
+#include <string>
+#include <vector>
+
+namespace zyra {
+
+// Quanto cada página envia para o navegador
+struct PageReport {
+    std::string page;       // Arquivo HTML da página
+    size_t components = 0;  // Componentes carregados pela página
+    size_t bytes = 0;       // HTML + todos os scripts carregados
+};
+
+// Build de um site com várias páginas (zyra <pasta>).
+// Cada .zy em <pasta>/pages (ou na própria pasta, se não houver pages/)
+// gera uma página própria; os demais .zy da pasta fornecem componentes.
+// Cada página carrega só os componentes que usa (direta ou indiretamente);
+// os usados por mais de uma página vão para um chunk compartilhado.
+class SiteBuilder {
+public:
+    explicit SiteBuilder(std::string root, BuildOptions options = {});
+    
+    std::vector<Artifact> build();
+    
+    // Relatório do último build, uma entrada por página
+    const std::vector<PageReport>& report() const { return pages; }
+    
+    // Eliminação de código morto do último build, um por componente
+    const std::vector<DceReport>& dceReport() const { return reports; }
+
+private:
+    std::string root;
+    BuildOptions options;
+    std::vector<PageReport> pages;
+    std::vector<DceReport> reports;
+};
+
+} // namespace zyra
+
+#endif
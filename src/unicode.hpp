@@ -0,0 +1,19 @@
+#ifndef ZYRA_UNICODE_H
+#define ZYRA_UNICODE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zyra {
+
+// Propriedades Unicode usadas em identificadores (UAX #31)
+bool isXidStart(std::uint32_t cp);
+bool isXidContinue(std::uint32_t cp);
+
+// Decodifica um caractere UTF-8 em 'cp'.
+// Retorna o número de bytes consumidos, ou 0 se a sequência for inválida.
+int decodeUtf8(const char* text, size_t length, std::uint32_t& cp);
+
+} // namespace zyra
+
+#endif
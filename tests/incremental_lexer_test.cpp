@@ -0,0 +1,282 @@
+// Teste do lexer incremental: aplica edições aleatórias (semente fixa) e
+// compara o fluxo mantido por IncrementalLexer com um scan completo do
+// mesmo fonte, campo a campo.
+
+#include "lexer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace zyra;
+
+namespace {
+
+const char* baseSource = R"(// Contador simples
+component Contador {
+  state {
+    titulo = "Olá, Zyra!"
+    contador = 0
+    ativo = true
+  }
+
+  style {
+    cor = #4287f5
+    fundo = #fff
+    tamanho = 2.5em
+    largura = 100%
+  }
+
+  eventos {
+    incrementar -> {
+      contador += 1
+      atualizar()
+    }
+
+    alternar -> {
+      ativo = !ativo
+      if ativo {
+        contador -= 1
+      } else {
+        contador = 0
+      }
+    }
+  }
+
+  interface {
+    Titulo {
+      texto: "Total: ${contador}"
+      cor: cores.primaria
+    }
+    Botao {
+      texto: "Mais"
+      acao: incrementar
+    }
+  }
+}
+)";
+
+// Fragmentos inseridos pelas edições; cobrem os casos de lookahead do lexer
+const std::vector<std::string> fragments = {
+    "a", "1", "12px", "-", "->", "\"", "\n", "//", "#fff", " ", "{", "}",
+    "x1", "2.5", "%", ".", "=", "+=", "-=", "!", "(", ")",
+    // Identificadores UTF-8, sequências truncadas (\xc3 sozinho, \xe2\x82 sem
+    // o último byte) e caracteres que não podem formar identificadores (€)
+    "é", "ção", "título", "\xc3", "\xe2\x82", "€", "_",
+};
+
+const int rounds = 2000;
+const int editsPerRound = 5;
+const int longSessionEdits = 3000;
+
+bool sameToken(const Token& a, const Token& b) {
+    return a.type == b.type && a.lexeme == b.lexeme && a.line == b.line &&
+           a.start == b.start && a.end == b.end && a.symbol == b.symbol;
+}
+
+// Os símbolos vêm de tabelas diferentes (a da sessão incremental e a atual),
+// então são comparados pelo nome
+bool sameScan(const Token& a, const Interner& names, const Token& b) {
+    return a.type == b.type && a.lexeme == b.lexeme && a.line == b.line &&
+           a.start == b.start && a.end == b.end &&
+           names.name(a.symbol) == Interner::current().name(b.symbol);
+}
+
+// Retorna o índice do primeiro token divergente, ou -1 se os fluxos coincidem
+long firstMismatch(const IncrementalLexer& lexer, const std::vector<Token>& full) {
+    const std::vector<Token>& incremental = lexer.tokens();
+    size_t count = std::min(incremental.size(), full.size());
+    for (size_t i = 0; i < count; i++) {
+        if (!sameScan(incremental[i], lexer.names(), full[i])) {
+            return static_cast<long>(i);
+        }
+    }
+    if (incremental.size() != full.size()) {
+        return static_cast<long>(count);
+    }
+    return -1;
+}
+
+// Aplica o delta ao fluxo anterior, como faria um editor, e compara com o atual
+bool deltaRebuilds(const std::vector<Token>& previous, const TokenDelta& delta,
+                   const std::vector<Token>& current) {
+    if (delta.first + delta.removed > previous.size()) return false;
+    
+    std::vector<Token> rebuilt(previous.begin(), previous.begin() + delta.first);
+    rebuilt.insert(rebuilt.end(), delta.inserted.begin(), delta.inserted.end());
+    for (size_t i = delta.first + delta.removed; i < previous.size(); i++) {
+        rebuilt.push_back(previous[i]);
+        rebuilt.back().start += delta.shift;
+        rebuilt.back().end += delta.shift;
+        rebuilt.back().line += delta.lineShift;
+    }
+    
+    return rebuilt.size() == current.size() &&
+           std::equal(rebuilt.begin(), rebuilt.end(), current.begin(), sameToken);
+}
+
+// Edição aleatória; 'large' permite remoções longas e inserções de trechos
+// inteiros, que atravessam e criam blocos do lexer incremental
+TextEdit randomEdit(std::mt19937& rng, const std::string& source, bool large) {
+    int size = static_cast<int>(source.size());
+    int start = static_cast<int>(rng() % (size + 1));
+    int length = large && rng() % 8 == 0 ? static_cast<int>(rng() % 3000) : static_cast<int>(rng() % 4);
+    int end = std::min(size, start + length);
+    
+    std::string replacement;
+    if (large && rng() % 8 == 0) {
+        replacement = baseSource;
+    } else {
+        for (int k = static_cast<int>(rng() % 3); k > 0; k--) {
+            replacement += fragments[rng() % fragments.size()];
+        }
+    }
+    return {start, end, replacement};
+}
+
+// Aplica a edição e confere o fonte, o delta e o fluxo contra um scan completo.
+// Retorna falso (e descreve o problema) se algo divergir.
+bool checkEdit(IncrementalLexer& lexer, const TextEdit& edit, int& checked) {
+    std::string expected = lexer.source();
+    expected.replace(edit.start, edit.end - edit.start, edit.replacement);
+    std::vector<Token> previous = lexer.tokens();
+    
+    bool incrementalThrew = false;
+    TokenDelta delta;
+    try {
+        delta = lexer.applyEdit(edit);
+    } catch (const std::exception&) {
+        incrementalThrew = true;
+    }
+    
+    bool fullThrew = false;
+    std::vector<Token> full;
+    try {
+        full = Lexer(expected).scanTokens();
+    } catch (const std::exception&) {
+        fullThrew = true;
+    }
+    
+    if (lexer.source() != expected) {
+        std::cerr << "Fonte divergente após a edição\n";
+        return false;
+    }
+    if (incrementalThrew != fullThrew) {
+        std::cerr << "Scan completo " << (fullThrew ? "falhou" : "passou") << ", incremental "
+                  << (incrementalThrew ? "falhou" : "passou") << "\n";
+        return false;
+    }
+    if (incrementalThrew) {
+        // Depois de uma falha o fluxo continua o anterior
+        if (!deltaRebuilds(previous, TokenDelta{0, 0, {}, 0, 0}, lexer.tokens())) {
+            std::cerr << "Fluxo alterado por uma edição que falhou\n";
+            return false;
+        }
+        return true;
+    }
+    
+    long index = firstMismatch(lexer, full);
+    if (index >= 0) {
+        std::cerr << "Token " << index << " divergente. Fonte:\n" << expected << "\n";
+        return false;
+    }
+    if (!deltaRebuilds(previous, delta, lexer.tokens())) {
+        std::cerr << "Delta não reconstrói o fluxo (first " << delta.first << ", removed "
+                  << delta.removed << ", inserted " << delta.inserted.size() << ")\n";
+        return false;
+    }
+    checked++;
+    return true;
+}
+
+} // namespace
+
+int main() {
+    Interner names;
+    InternerScope scope(names);
+    std::mt19937 rng(42);
+    int checked = 0;
+    
+    for (int round = 0; round < rounds; round++) {
+        IncrementalLexer lexer(baseSource);
+        for (int e = 0; e < editsPerRound; e++) {
+            if (!checkEdit(lexer, randomEdit(rng, lexer.source(), false), checked)) {
+                std::cerr << "Rodada " << round << ", edição " << e << "\n";
+                return 1;
+            }
+        }
+    }
+    
+    // Sessão longa num arquivo com vários blocos de tokens
+    std::string large;
+    for (int i = 0; i < 40; i++) large += baseSource;
+    IncrementalLexer lexer(large);
+    int longChecked = 0;
+    for (int e = 0; e < longSessionEdits; e++) {
+        TextEdit edit = randomEdit(rng, lexer.source(), true);
+        std::string removed = lexer.source().substr(edit.start, edit.end - edit.start);
+        int before = longChecked;
+        bool ok = checkEdit(lexer, edit, longChecked);
+        
+        // Edição que quebrou o fonte: desfaz, como o usuário faria no editor
+        if (ok && longChecked == before) {
+            int end = edit.start + static_cast<int>(edit.replacement.size());
+            ok = checkEdit(lexer, {edit.start, end, removed}, longChecked);
+        }
+        if (!ok) {
+            std::cerr << "Sessão longa, edição " << e << "\n";
+            return 1;
+        }
+    }
+    checked += longChecked;
+    
+    // Sessão longa digitando nomes sempre novos: a tabela da sessão precisa
+    // ser compactada em vez de guardar todos eles
+    IncrementalLexer session(baseSource);
+    size_t largest = 0;
+    for (int i = 0; i < 50000; i++) {
+        int at = static_cast<int>(session.source().find("contador = 0"));
+        std::string name = "n" + std::to_string(i);
+        session.applyEdit({at, at + static_cast<int>(std::string("contador").size()), name});
+        session.applyEdit({at, at + static_cast<int>(name.size()), "contador"});
+        largest = std::max(largest, session.names().size());
+    }
+    if (largest > 10000) {
+        std::cerr << "Tabela de nomes da sessão cresceu para " << largest << " nomes\n";
+        return 1;
+    }
+    if (firstMismatch(session, Lexer(session.source()).scanTokens()) >= 0) {
+        std::cerr << "Fluxo divergente após compactar a tabela de nomes\n";
+        return 1;
+    }
+    
+    // Os nomes dos tokens vêm da tabela da sessão, não da tabela atual
+    Lexer("component Outro {}").scanTokens();
+    IncrementalLexer named("component Foo {}");
+    if (named.tokens()[1].text(named.names()) != "Foo") {
+        std::cerr << "Nome resolvido na tabela errada: " << named.tokens()[1].text(named.names()) << "\n";
+        return 1;
+    }
+    
+    // Custo por edição num arquivo grande (~30.000 linhas): deve depender da
+    // região editada e não do tamanho do arquivo. Só informativo; o tempo
+    // depende da máquina e do tipo de build.
+    std::string huge;
+    while (std::count(huge.begin(), huge.end(), '\n') < 30000) huge += baseSource;
+    IncrementalLexer editor(huge);
+    int at = static_cast<int>(huge.find("contador = 0", huge.size() / 2));
+    const int timedEdits = 2000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < timedEdits; i++) {
+        editor.applyEdit({at, at, "a"});
+        editor.applyEdit({at, at + 1, ""});
+    }
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    
+    std::cout << checked << " edições verificadas\n";
+    std::cout << "Arquivo de " << std::count(huge.begin(), huge.end(), '\n') << " linhas: "
+              << micros / (2 * timedEdits) << " µs por edição\n";
+    return 0;
+}